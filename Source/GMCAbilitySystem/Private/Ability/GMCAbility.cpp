@@ -94,12 +94,9 @@ bool UGMCAbility::CanAffordAbilityCost() const
 	UGMCAbilityEffect* AbilityEffect = AbilityCost->GetDefaultObject<UGMCAbilityEffect>();
 	for (FGMCAttributeModifier AttributeModifier : AbilityEffect->EffectData.Modifiers)
 	{
-		for (const FAttribute* Attribute : OwnerAbilityComponent->GetAllAttributes())
+		if (const FAttribute* Attribute = OwnerAbilityComponent->GetAttributeByTag(AttributeModifier.AttributeTag))
 		{
-			if (Attribute->Tag.MatchesTagExact(AttributeModifier.AttributeTag))
-			{
-				if (Attribute->Value + AttributeModifier.Value < 0) return false;
-			}
+			if (Attribute->Value + AttributeModifier.Value < 0) return false;
 		}
 	}
 
@@ -122,16 +119,15 @@ void UGMCAbility::CommitAbilityCost()
 {
 	if (AbilityCost == nullptr || OwnerAbilityComponent == nullptr) return;
 
-	const UGMCAbilityEffect* EffectCDO = DuplicateObject(AbilityCost->GetDefaultObject<UGMCAbilityEffect>(), this);
-	FGMCAbilityEffectData EffectData = EffectCDO->EffectData;
-	EffectData.OwnerAbilityComponent = OwnerAbilityComponent;
-	AbilityCostInstance = OwnerAbilityComponent->ApplyAbilityEffect(DuplicateObject(EffectCDO, this), EffectData);
+	// Applied with its class defaults, which lets lightweight cost effects skip the effect object.
+	AbilityCostEffectID = OwnerAbilityComponent->ApplyAbilityEffectByID(AbilityCost, FGMCAbilityEffectData{});
 }
 
 void UGMCAbility::RemoveAbilityCost() {
-	if (AbilityCostInstance) {
-		OwnerAbilityComponent->RemoveActiveAbilityEffect(AbilityCostInstance);
+	if (AbilityCostEffectID != 0 && OwnerAbilityComponent) {
+		OwnerAbilityComponent->RemoveActiveAbilityEffectByID(AbilityCostEffectID);
 	}
+	AbilityCostEffectID = 0;
 }
 
 
@@ -0,0 +1,115 @@
+#include "Attributes/GMCAttributeClampGraph.h"
+
+#include "GMCAbilitySystem.h"
+#include "Attributes/GMCAttributeClamp.h"
+#include "Algo/Sort.h"
+
+void FGMCAttributeClampGraph::Build(int32 NumNodes, TFunctionRef<const FGameplayTag&(int32)> GetTag, TFunctionRef<const FAttributeClamp&(int32)> GetClamp,
+	TFunctionRef<int32(const FGameplayTag&)> ResolveNode)
+{
+	Reset();
+
+	const int32 Count = NumNodes;
+	MinSource.Init(INDEX_NONE, Count);
+	MaxSource.Init(INDEX_NONE, Count);
+
+	// Direct edges, from the clamping attribute to the clamped one.
+	TArray<TArray<int32>> Children;
+	Children.SetNum(Count);
+	TArray<int32> InDegree;
+	InDegree.Init(0, Count);
+
+	for (int32 Node = 0; Node < Count; ++Node)
+	{
+		const FAttributeClamp& Clamp = GetClamp(Node);
+		if (Clamp.MinAttributeTag.IsValid())
+		{
+			MinSource[Node] = ResolveNode(Clamp.MinAttributeTag);
+		}
+		if (Clamp.MaxAttributeTag.IsValid())
+		{
+			MaxSource[Node] = ResolveNode(Clamp.MaxAttributeTag);
+		}
+
+		for (const int32 Source : {MinSource[Node], MaxSource[Node]})
+		{
+			if (Source != INDEX_NONE && !Children[Source].Contains(Node))
+			{
+				Children[Source].Add(Node);
+				++InDegree[Node];
+			}
+		}
+	}
+
+	// Kahn's algorithm, nodes left with incoming edges afterwards are part of (or downstream of) a cycle.
+	Rank.Init(INDEX_NONE, Count);
+	TArray<int32> Queue;
+	Queue.Reserve(Count);
+	for (int32 Node = 0; Node < Count; ++Node)
+	{
+		if (InDegree[Node] == 0)
+		{
+			Queue.Add(Node);
+		}
+	}
+	for (int32 Head = 0; Head < Queue.Num(); ++Head)
+	{
+		const int32 Node = Queue[Head];
+		Rank[Node] = Head;
+		for (const int32 Child : Children[Node])
+		{
+			if (--InDegree[Child] == 0)
+			{
+				Queue.Add(Child);
+			}
+		}
+	}
+
+	if (Queue.Num() != Count)
+	{
+		FString Cyclic;
+		for (int32 Node = 0; Node < Count; ++Node)
+		{
+			if (Rank[Node] == INDEX_NONE)
+			{
+				Cyclic += (Cyclic.IsEmpty() ? TEXT("") : TEXT(", ")) + GetTag(Node).ToString();
+			}
+		}
+		UE_LOG(LogGMCAbilitySystem, Error, TEXT("Attribute clamps form a cycle, changes will not be propagated to: %s"), *Cyclic);
+	}
+
+	// Flatten the transitive dependents of every node, sorted by topological rank.
+	DependentOffsets.Reserve(Count + 1);
+	TArray<int32> Stack;
+	TBitArray<> Visited;
+	for (int32 Node = 0; Node < Count; ++Node)
+	{
+		DependentOffsets.Add(Dependents.Num());
+		if (Rank[Node] == INDEX_NONE) continue;
+
+		const int32 First = Dependents.Num();
+		Visited.Init(false, Count);
+		Stack.Reset();
+		Stack.Append(Children[Node]);
+		while (!Stack.IsEmpty())
+		{
+			const int32 Child = Stack.Pop();
+			if (Visited[Child] || Rank[Child] == INDEX_NONE) continue;
+			Visited[Child] = true;
+			Dependents.Add(Child);
+			Stack.Append(Children[Child]);
+		}
+
+		Algo::Sort(MakeArrayView(Dependents.GetData() + First, Dependents.Num() - First), [this](int32 A, int32 B) { return Rank[A] < Rank[B]; });
+	}
+	DependentOffsets.Add(Dependents.Num());
+}
+
+void FGMCAttributeClampGraph::Reset()
+{
+	MinSource.Reset();
+	MaxSource.Reset();
+	Rank.Reset();
+	DependentOffsets.Reset();
+	Dependents.Reset();
+}
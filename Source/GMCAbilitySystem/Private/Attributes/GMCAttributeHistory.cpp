@@ -0,0 +1,133 @@
+#include "Attributes/GMCAttributeHistory.h"
+
+#include "GMCAbilitySystem.h"
+
+void FGMCAttributeHistory::Init(int32 InCapacity, int32 InNumAttributes)
+{
+	Capacity = FMath::Max(InCapacity, 0);
+	NumAttributes = FMath::Max(InNumAttributes, 0);
+
+	Times.Init(0.0, Capacity);
+	Values.Init(0.f, Capacity * NumAttributes);
+	TagBits.Init(0, Capacity * NumTagWords);
+
+	Reset();
+}
+
+void FGMCAttributeHistory::Reset()
+{
+	Head = 0;
+	Count = 0;
+}
+
+TArrayView<float> FGMCAttributeHistory::Record(double Time, const FGameplayTagContainer& ActiveTags)
+{
+	if (!IsEnabled()) return {};
+
+	// Moves are being replayed, the snapshots from the previous run of these moves are outdated.
+	while (Count > 0 && Times[GetBufferIndex(Count - 1)] >= Time)
+	{
+		--Count;
+		Head = (Head - 1 + Capacity) % Capacity;
+	}
+
+	const int32 Index = Head;
+	Head = (Head + 1) % Capacity;
+	Count = FMath::Min(Count + 1, Capacity);
+
+	Times[Index] = Time;
+
+	uint64* Bits = TagBits.GetData() + Index * NumTagWords;
+	FMemory::Memzero(Bits, NumTagWords * sizeof(uint64));
+	for (const FGameplayTag& Tag : ActiveTags)
+	{
+		int32 TagIndex = INDEX_NONE;
+		if (const int32* FoundIndex = RecordedTagIndices.Find(Tag))
+		{
+			TagIndex = *FoundIndex;
+		}
+		else if (RecordedTags.Num() < MaxRecordedTags)
+		{
+			TagIndex = RecordedTags.Add(Tag);
+			RecordedTagIndices.Add(Tag, TagIndex);
+		}
+		else
+		{
+			if (!bReportedTagOverflow)
+			{
+				UE_LOG(LogGMCAbilitySystem, Warning, TEXT("Attribute history can't record more than %d distinct tags, %s will not be recorded."), MaxRecordedTags, *Tag.ToString());
+				bReportedTagOverflow = true;
+			}
+			continue;
+		}
+
+		Bits[TagIndex / 64] |= uint64(1) << (TagIndex % 64);
+	}
+
+	return TArrayView<float>(Values.GetData() + Index * NumAttributes, NumAttributes);
+}
+
+int32 FGMCAttributeHistory::FindSnapshot(double Time) const
+{
+	if (Count == 0 || Time < Times[GetBufferIndex(0)]) return INDEX_NONE;
+
+	// Last snapshot whose time is lower or equal to Time.
+	int32 Low = 0;
+	int32 High = Count - 1;
+	while (Low < High)
+	{
+		const int32 Middle = (Low + High + 1) / 2;
+		if (Times[GetBufferIndex(Middle)] <= Time)
+		{
+			Low = Middle;
+		}
+		else
+		{
+			High = Middle - 1;
+		}
+	}
+	return Low;
+}
+
+bool FGMCAttributeHistory::SampleValue(int32 Slot, double Time, float& OutValue) const
+{
+	if (Slot < 0 || Slot >= NumAttributes) return false;
+
+	const int32 Age = FindSnapshot(Time);
+	if (Age == INDEX_NONE) return false;
+
+	const int32 Index = GetBufferIndex(Age);
+	const float Value = Values[Index * NumAttributes + Slot];
+	if (Age == Count - 1)
+	{
+		OutValue = Value;
+		return true;
+	}
+
+	const int32 NextIndex = GetBufferIndex(Age + 1);
+	const float NextValue = Values[NextIndex * NumAttributes + Slot];
+	const double Alpha = (Time - Times[Index]) / FMath::Max(Times[NextIndex] - Times[Index], UE_DOUBLE_SMALL_NUMBER);
+	OutValue = FMath::Lerp(Value, NextValue, static_cast<float>(Alpha));
+	return true;
+}
+
+bool FGMCAttributeHistory::SampleTag(const FGameplayTag& Tag, double Time, bool bExact, bool& bOutActive) const
+{
+	const int32 Age = FindSnapshot(Time);
+	if (Age == INDEX_NONE) return false;
+
+	const uint64* Bits = TagBits.GetData() + GetBufferIndex(Age) * NumTagWords;
+	bOutActive = false;
+	for (int32 TagIndex = 0; TagIndex < RecordedTags.Num(); ++TagIndex)
+	{
+		if ((Bits[TagIndex / 64] & (uint64(1) << (TagIndex % 64))) == 0) continue;
+
+		const FGameplayTag& RecordedTag = RecordedTags[TagIndex];
+		if (bExact ? RecordedTag == Tag : RecordedTag.MatchesTag(Tag))
+		{
+			bOutActive = true;
+			break;
+		}
+	}
+	return true;
+}
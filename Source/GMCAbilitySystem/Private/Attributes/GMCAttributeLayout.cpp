@@ -0,0 +1,247 @@
+#include "Attributes/GMCAttributeLayout.h"
+
+#include "GMCAbilitySystem.h"
+#include "Attributes/GMCAttributesData.h"
+
+namespace
+{
+	// Ordered list of the data assets a layout was compiled from.
+	struct FGMCAttributeLayoutKey
+	{
+		TArray<FObjectKey> DataAssets;
+
+		bool operator==(const FGMCAttributeLayoutKey& Other) const { return DataAssets == Other.DataAssets; }
+
+		friend uint32 GetTypeHash(const FGMCAttributeLayoutKey& Key)
+		{
+			uint32 Hash = 0;
+			for (const FObjectKey& DataAsset : Key.DataAssets)
+			{
+				Hash = HashCombine(Hash, GetTypeHash(DataAsset));
+			}
+			return Hash;
+		}
+	};
+
+	// Layouts are only held weakly, they go away with the last component using them.
+	TMap<FGMCAttributeLayoutKey, TWeakPtr<const FGMCAttributeLayout>>& GetLayoutCache()
+	{
+		static TMap<FGMCAttributeLayoutKey, TWeakPtr<const FGMCAttributeLayout>> Cache;
+		return Cache;
+	}
+}
+
+TSharedRef<const FGMCAttributeLayout> FGMCAttributeLayout::Get(TConstArrayView<UGMCAttributesData*> DataAssets)
+{
+	check(IsInGameThread());
+
+	FGMCAttributeLayoutKey Key;
+	Key.DataAssets.Reserve(DataAssets.Num());
+	for (const UGMCAttributesData* DataAsset : DataAssets)
+	{
+		// Avoid crashing in an editor preview if we're actually editing the ability component's attribute table.
+		if (DataAsset)
+		{
+			Key.DataAssets.Add(DataAsset);
+		}
+	}
+
+	TWeakPtr<const FGMCAttributeLayout>& CachedLayout = GetLayoutCache().FindOrAdd(Key);
+	if (TSharedPtr<const FGMCAttributeLayout> Layout = CachedLayout.Pin())
+	{
+		return Layout.ToSharedRef();
+	}
+
+	const TSharedRef<FGMCAttributeLayout> Layout = MakeShared<FGMCAttributeLayout>();
+	Layout->Build(DataAssets);
+	CachedLayout = Layout;
+	return Layout;
+}
+
+void FGMCAttributeLayout::InvalidateCache()
+{
+	GetLayoutCache().Reset();
+}
+
+void FGMCAttributeLayout::Build(TConstArrayView<UGMCAttributesData*> DataAssets)
+{
+	TArray<FGMCAttributeLayoutEntry> BoundEntries;
+	TArray<FGMCAttributeLayoutEntry> UnboundEntries;
+
+	for (const UGMCAttributesData* DataAsset : DataAssets)
+	{
+		if (!DataAsset) continue;
+
+		for (const FAttributeData& AttributeData : DataAsset->AttributeData)
+		{
+			FGMCAttributeLayoutEntry& Entry = (AttributeData.bGMCBound ? BoundEntries : UnboundEntries).AddDefaulted_GetRef();
+			Entry.Tag = AttributeData.AttributeTag;
+			Entry.DefaultValue = AttributeData.DefaultValue;
+			Entry.Clamp = AttributeData.Clamp;
+			Entry.Clamp.AbilityComponent = nullptr;
+			Entry.RegenAttributeTag = AttributeData.RegenAttributeTag;
+			Entry.RegenBlockingTags = AttributeData.RegenBlockingTags;
+			Entry.bIsGMCBound = AttributeData.bGMCBound;
+			Entry.Quantization = AttributeData.Quantization;
+			Entry.ModifierChannels = static_cast<EGMCAttributeModifierChannel>(AttributeData.ModifierChannels) & EGMCAttributeModifierChannel::All;
+		}
+	}
+
+	// We sort our bound attributes alphabetically by tag so that the binding order is deterministic.
+	// Sorted once for the whole layout, the sort is stable so that duplicated tags keep their declaration order.
+	BoundEntries.StableSort([](const FGMCAttributeLayoutEntry& A, const FGMCAttributeLayoutEntry& B)
+	{
+		return IsBoundBefore(A.Tag, B.Tag);
+	});
+
+	NumBound = BoundEntries.Num();
+	Entries = MoveTemp(BoundEntries);
+	Entries.Append(MoveTemp(UnboundEntries));
+
+	DefaultValues.Reserve(Entries.Num());
+	for (const FGMCAttributeLayoutEntry& Entry : Entries)
+	{
+		DefaultValues.Add(Entry.DefaultValue);
+	}
+
+	// Unbound attributes are registered first so that they take priority, as they did with the former linear search.
+	SlotByTag.Reserve(Entries.Num());
+	for (int32 Slot = NumBound; Slot < Entries.Num(); ++Slot)
+	{
+		if (Entries[Slot].Tag.IsValid() && !SlotByTag.Contains(Entries[Slot].Tag))
+		{
+			SlotByTag.Add(Entries[Slot].Tag, Slot);
+		}
+	}
+	for (int32 Slot = 0; Slot < NumBound; ++Slot)
+	{
+		if (Entries[Slot].Tag.IsValid() && !SlotByTag.Contains(Entries[Slot].Tag))
+		{
+			SlotByTag.Add(Entries[Slot].Tag, Slot);
+		}
+	}
+
+	ClampGraph.Build(Entries.Num(),
+		[this](int32 Slot) -> const FGameplayTag& { return Entries[Slot].Tag; },
+		[this](int32 Slot) -> const FAttributeClamp& { return Entries[Slot].Clamp; },
+		[this](const FGameplayTag& Tag) { return FindSlot(Tag); });
+
+	// Regens may drop the quantization of their target, so they are built before the quantized channels.
+	BuildRegens();
+	BuildQuantizedChannels();
+}
+
+void FGMCAttributeLayout::BuildRegens()
+{
+	for (int32 Slot = 0; Slot < Entries.Num(); ++Slot)
+	{
+		FGMCAttributeLayoutEntry& Entry = Entries[Slot];
+		if (!Entry.RegenAttributeTag.IsValid()) continue;
+
+		// Regen runs in the prediction tick, which is replayed on corrections. Unbound attributes wouldn't be rolled back.
+		if (!Entry.bIsGMCBound)
+		{
+			UE_LOG(LogGMCAbilitySystem, Warning, TEXT("Attribute %s has a regen attribute but isn't bound to the GMC, it will not regenerate."), *Entry.Tag.ToString());
+			continue;
+		}
+
+		const int32 RateSlot = FindSlot(Entry.RegenAttributeTag);
+		if (RateSlot == INDEX_NONE)
+		{
+			UE_LOG(LogGMCAbilitySystem, Warning, TEXT("Attribute %s regenerates from %s, which doesn't exist."), *Entry.Tag.ToString(), *Entry.RegenAttributeTag.ToString());
+			continue;
+		}
+
+		// The rate is read during replays as well, it has to be rolled back with the attribute it regenerates.
+		if (RateSlot >= NumBound)
+		{
+			UE_LOG(LogGMCAbilitySystem, Warning, TEXT("Attribute %s regenerates from %s, which isn't bound to the GMC, it will not regenerate."), *Entry.Tag.ToString(), *Entry.RegenAttributeTag.ToString());
+			continue;
+		}
+
+		// Quantized attributes are snapped to their step at the start of every prediction tick, any regen step
+		// smaller than half of it would be rounded away every tick. Regenerated attributes are bound at full precision.
+		if (Entry.Quantization.IsQuantized())
+		{
+			UE_LOG(LogGMCAbilitySystem, Warning, TEXT("Attribute %s regenerates, it will be bound at full precision instead of being quantized."), *Entry.Tag.ToString());
+			Entry.Quantization.Precision = EGMCAttributePrecision::Full;
+		}
+
+		FGMCAttributeRegen& Regen = Regens.AddDefaulted_GetRef();
+		Regen.Slot = Slot;
+		Regen.RateSlot = RateSlot;
+		AllRegenBlockingTags.AppendTags(Entry.RegenBlockingTags);
+	}
+}
+
+void FGMCAttributeLayout::BuildQuantizedChannels()
+{
+	// Word with a free upper half, if any.
+	int32 PendingHalfWord = INDEX_NONE;
+
+	auto AddChannel = [this, &PendingHalfWord](int32 Slot, EGMCAttributeChannel Channel, EGMCAttributePrecision Codec)
+	{
+		FGMCQuantizedAttributeChannel& QuantizedChannel = QuantizedChannels.AddDefaulted_GetRef();
+		QuantizedChannel.Slot = Slot;
+		QuantizedChannel.Channel = Channel;
+		QuantizedChannel.Codec = Codec;
+
+		if (Codec == EGMCAttributePrecision::Integer)
+		{
+			QuantizedChannel.Word = NumQuantizedWords++;
+		}
+		else if (PendingHalfWord != INDEX_NONE)
+		{
+			QuantizedChannel.Word = PendingHalfWord;
+			QuantizedChannel.Shift = 16;
+			PendingHalfWord = INDEX_NONE;
+		}
+		else
+		{
+			QuantizedChannel.Word = PendingHalfWord = NumQuantizedWords++;
+		}
+	};
+
+	for (int32 Slot = 0; Slot < NumBound; ++Slot)
+	{
+		FGMCAttributeLayoutEntry& Entry = Entries[Slot];
+		FGMCAttributeQuantization& Quantization = Entry.Quantization;
+		if (!Quantization.IsQuantized()) continue;
+
+		if (Quantization.Precision == EGMCAttributePrecision::FixedPoint)
+		{
+			if (Quantization.FixedPointStep <= 0.f)
+			{
+				UE_LOG(LogGMCAbilitySystem, Warning, TEXT("Attribute %s has a fixed point step of %f, it will be bound at full precision."), *Entry.Tag.ToString(), Quantization.FixedPointStep);
+				Quantization.Precision = EGMCAttributePrecision::Full;
+				continue;
+			}
+
+			const FAttributeClamp& Clamp = Entry.Clamp;
+			const float LowestValue = Quantization.FixedPointOrigin + MIN_int16 * Quantization.FixedPointStep;
+			const float HighestValue = Quantization.FixedPointOrigin + MAX_int16 * Quantization.FixedPointStep;
+			if (Clamp.IsSet() && !Clamp.MinAttributeTag.IsValid() && !Clamp.MaxAttributeTag.IsValid() &&
+				(Clamp.Min < LowestValue || Clamp.Max > HighestValue))
+			{
+				UE_LOG(LogGMCAbilitySystem, Warning, TEXT("Attribute %s clamp range [%f, %f] doesn't fit its fixed point range, values will saturate."), *Entry.Tag.ToString(), Clamp.Min, Clamp.Max);
+			}
+		}
+
+		AddChannel(Slot, EGMCAttributeChannel::BaseValue, Quantization.Precision);
+		AddChannel(Slot, EGMCAttributeChannel::Value, Quantization.Precision);
+		if (Entry.IsModifierChannelBound(EGMCAttributeModifierChannel::Additive))
+		{
+			AddChannel(Slot, EGMCAttributeChannel::AdditiveModifier, Quantization.Precision);
+		}
+
+		// Multiply/Divide modifiers are small factors, 16 bit floats are precise enough for them whatever the precision.
+		if (Entry.IsModifierChannelBound(EGMCAttributeModifierChannel::Multiply))
+		{
+			AddChannel(Slot, EGMCAttributeChannel::MultiplyModifier, EGMCAttributePrecision::Half);
+		}
+		if (Entry.IsModifierChannelBound(EGMCAttributeModifierChannel::Divide))
+		{
+			AddChannel(Slot, EGMCAttributeChannel::DivisionModifier, EGMCAttributePrecision::Half);
+		}
+	}
+}
@@ -0,0 +1,104 @@
+#include "Attributes/GMCAttributeModifierAggregator.h"
+
+void FGMCAttributeModifierAggregator::Init(int32 NumAttributes)
+{
+	Sums.Reset();
+	Sums.SetNum(NumAttributes);
+	ModifiersByEffect.Reset();
+}
+
+void FGMCAttributeModifierAggregator::Add(int32 EffectID, int32 Slot, EModifierType ModifierType, float Value)
+{
+	if (!Sums.IsValidIndex(Slot)) return;
+
+	ModifiersByEffect.FindOrAdd(EffectID).Add({Slot, ModifierType, Value});
+
+	FChannelSums& Channels = Sums[Slot];
+	const int32 Channel = GetChannelIndex(ModifierType);
+	Channels.EffectSum[Channel] += Value;
+	++Channels.NumEffectModifiers[Channel];
+}
+
+void FGMCAttributeModifierAggregator::AddUnowned(int32 Slot, EModifierType ModifierType, float Value)
+{
+	if (!Sums.IsValidIndex(Slot)) return;
+
+	Sums[Slot].UnownedSum[GetChannelIndex(ModifierType)] += Value;
+}
+
+void FGMCAttributeModifierAggregator::Remove(int32 EffectID, FEffectModifiers& OutModifiers)
+{
+	if (!ModifiersByEffect.RemoveAndCopyValue(EffectID, OutModifiers)) return;
+
+	for (const FEffectModifier& Modifier : OutModifiers)
+	{
+		FChannelSums& Channels = Sums[Modifier.Slot];
+		const int32 Channel = GetChannelIndex(Modifier.ModifierType);
+		if (--Channels.NumEffectModifiers[Channel] <= 0)
+		{
+			// Last contribution, whatever rounding error is left goes away with it.
+			Channels.NumEffectModifiers[Channel] = 0;
+			Channels.EffectSum[Channel] = 0;
+		}
+		else
+		{
+			Channels.EffectSum[Channel] -= Modifier.Value;
+		}
+	}
+}
+
+void FGMCAttributeModifierAggregator::ResetChannel(int32 Slot, EModifierType ModifierType)
+{
+	if (!Sums.IsValidIndex(Slot)) return;
+
+	const int32 Channel = GetChannelIndex(ModifierType);
+	for (auto It = ModifiersByEffect.CreateIterator(); It; ++It)
+	{
+		It.Value().RemoveAll([Slot, Channel](const FEffectModifier& Modifier)
+		{
+			return Modifier.Slot == Slot && GetChannelIndex(Modifier.ModifierType) == Channel;
+		});
+	}
+
+	FChannelSums& Channels = Sums[Slot];
+	Channels.EffectSum[Channel] = 0;
+	Channels.NumEffectModifiers[Channel] = 0;
+	Channels.UnownedSum[Channel] = 0;
+}
+
+float FGMCAttributeModifierAggregator::GetChannelValue(int32 Slot, EModifierType ModifierType) const
+{
+	return GetChannelValue(Slot, ModifierType, Sums.IsValidIndex(Slot) ? Sums[Slot].UnownedSum[GetChannelIndex(ModifierType)] : 0.0);
+}
+
+float FGMCAttributeModifierAggregator::GetChannelValue(int32 Slot, EModifierType ModifierType, double UnownedSum) const
+{
+	// Additive modifiers start at 0, multipliers and divisors at 1.
+	const double Identity = ModifierType == EModifierType::Add ? 0.0 : 1.0;
+	const double EffectSum = Sums.IsValidIndex(Slot) ? Sums[Slot].EffectSum[GetChannelIndex(ModifierType)] : 0.0;
+	return static_cast<float>(Identity + UnownedSum + EffectSum);
+}
+
+void FGMCAttributeModifierAggregator::GetContributions(int32 Slot, TArray<FGMCAttributeModifierContribution>& OutContributions) const
+{
+	if (!Sums.IsValidIndex(Slot)) return;
+
+	for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+	{
+		if (Sums[Slot].UnownedSum[Channel] != 0)
+		{
+			OutContributions.Add({INDEX_NONE, static_cast<EModifierType>(Channel), static_cast<float>(Sums[Slot].UnownedSum[Channel])});
+		}
+	}
+
+	for (const TPair<int32, FEffectModifiers>& Effect : ModifiersByEffect)
+	{
+		for (const FEffectModifier& Modifier : Effect.Value)
+		{
+			if (Modifier.Slot == Slot)
+			{
+				OutContributions.Add({Effect.Key, Modifier.ModifierType, Modifier.Value});
+			}
+		}
+	}
+}
@@ -7,14 +7,161 @@ void FAttribute::PostReplicatedAdd(const FGMCUnboundAttributeSet& InArraySeriali
 {
 	if (IsValid(AbilitySystem))
 	{
-		AbilitySystem->BroadcastAttributeChangeBySerializedItem(Tag, Value);
+		// The unbound layout changed on this client, the attribute lookup has to be rebuilt.
+		AbilitySystem->MarkAttributeLookupDirty();
+		AbilitySystem->BroadcastAttributeChangeBySerializedItem(Tag, LastReplicatedValue, Value);
 	}
+	LastReplicatedValue = Value;
 }
 
 void FAttribute::PostReplicatedChange(const struct FGMCUnboundAttributeSet& InArraySerializer)
+{
+	// The item may have changed without its value changing (e.g. only a modifier was updated).
+	if (IsValid(AbilitySystem) && LastReplicatedValue != Value)
+	{
+		AbilitySystem->BroadcastAttributeChangeBySerializedItem(Tag, LastReplicatedValue, Value);
+	}
+	LastReplicatedValue = Value;
+}
+
+void FAttribute::PreReplicatedRemove(const struct FGMCUnboundAttributeSet& InArraySerializer)
 {
 	if (IsValid(AbilitySystem))
 	{
-		AbilitySystem->BroadcastAttributeChangeBySerializedItem(Tag, Value);
+		AbilitySystem->MarkAttributeLookupDirty();
+	}
+}
+
+void FGMCAttributeColumns::CalculateValues()
+{
+	const int32 Count = Num();
+	const float* RESTRICT Base = BaseValue.GetData();
+	const float* RESTRICT Additive = AdditiveModifier.GetData();
+	const float* RESTRICT Multiply = MultiplyModifier.GetData();
+	const float* RESTRICT Division = DivisionModifier.GetData();
+	const float* RESTRICT Min = ClampMin.GetData();
+	const float* RESTRICT Max = ClampMax.GetData();
+	float* RESTRICT Out = Value.GetData();
+
+	const VectorRegister4Float Zero = VectorZeroFloat();
+	const VectorRegister4Float One = VectorOneFloat();
+
+	int32 Index = 0;
+	for (; Index + 4 <= Count; Index += 4)
+	{
+		// Prevent divide by 0 and negative divisors
+		const VectorRegister4Float Div = VectorLoad(Division + Index);
+		const VectorRegister4Float LocalDivision = VectorSelect(VectorCompareLE(Div, Zero), One, Div);
+
+		// Prevent negative multipliers
+		const VectorRegister4Float LocalMultiply = VectorMax(VectorLoad(Multiply + Index), Zero);
+
+		VectorRegister4Float Result = VectorDivide(VectorMultiply(VectorAdd(VectorLoad(Base + Index), VectorLoad(Additive + Index)), LocalMultiply), LocalDivision);
+
+		// Same semantics as FMath::Clamp, so that the batched and scalar paths always agree.
+		const VectorRegister4Float LocalMin = VectorLoad(Min + Index);
+		const VectorRegister4Float LocalMax = VectorLoad(Max + Index);
+		Result = VectorSelect(VectorCompareLT(Result, LocalMin), LocalMin, VectorSelect(VectorCompareLT(Result, LocalMax), Result, LocalMax));
+
+		VectorStore(Result, Out + Index);
+	}
+
+	// Remainder
+	for (; Index < Count; ++Index)
+	{
+		const float LocalDivision = Division[Index] <= 0 ? 1.f : Division[Index];
+		const float LocalMultiply = Multiply[Index] < 0 ? 0.f : Multiply[Index];
+		Out[Index] = FMath::Clamp(((Base[Index] + Additive[Index]) * LocalMultiply) / LocalDivision, Min[Index], Max[Index]);
+	}
+}
+
+void FGMCAttributeSet::EnableColumnStorage()
+{
+	DisableColumnStorage();
+
+	const int32 Count = Attributes.Num();
+	if (Count == 0) return;
+
+	Columns.BaseValue.Reserve(Count);
+	Columns.AdditiveModifier.Reserve(Count);
+	Columns.MultiplyModifier.Reserve(Count);
+	Columns.DivisionModifier.Reserve(Count);
+	Columns.Value.Reserve(Count);
+	Columns.ClampMin.Reserve(Count);
+	Columns.ClampMax.Reserve(Count);
+
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		const FAttribute& Attribute = Attributes[Index];
+		Columns.BaseValue.Add(Attribute.BaseValue);
+		Columns.AdditiveModifier.Add(Attribute.AdditiveModifier);
+		Columns.MultiplyModifier.Add(Attribute.MultiplyModifier);
+		Columns.DivisionModifier.Add(Attribute.DivisionModifier);
+		Columns.Value.Add(Attribute.Value);
+
+		const FAttributeClamp& Clamp = Attribute.Clamp;
+		if (Clamp.MinAttributeTag.IsValid() || Clamp.MaxAttributeTag.IsValid())
+		{
+			// Clamped by another attribute, resolved after the batched pass.
+			Columns.ClampMin.Add(-MAX_flt);
+			Columns.ClampMax.Add(MAX_flt);
+			Columns.DynamicClampIndices.Add(Index);
+		}
+		else if (Clamp.IsSet())
+		{
+			Columns.ClampMin.Add(Clamp.Min);
+			Columns.ClampMax.Add(Clamp.Max);
+		}
+		else
+		{
+			Columns.ClampMin.Add(-MAX_flt);
+			Columns.ClampMax.Add(MAX_flt);
+		}
+	}
+
+	BindColumnViews();
+}
+
+void FGMCAttributeSet::DisableColumnStorage()
+{
+	for (const FAttribute& Attribute : Attributes)
+	{
+		Attribute.SyncFromColumns();
+	}
+	Columns.Reset();
+	BindColumnViews();
+}
+
+void FGMCAttributeSet::CalculateValues()
+{
+	if (!UsesColumnStorage())
+	{
+		for (const FAttribute& Attribute : Attributes)
+		{
+			Attribute.CalculateValue();
+		}
+		return;
+	}
+
+	Columns.CalculateValues();
+
+	// Views have to be up to date before resolving attribute driven clamps, as those read other attributes.
+	for (const FAttribute& Attribute : Attributes)
+	{
+		Attribute.SyncFromColumns();
+	}
+
+	for (const int32 Index : Columns.DynamicClampIndices)
+	{
+		Attributes[Index].CalculateValue();
+	}
+}
+
+void FGMCAttributeSet::BindColumnViews()
+{
+	const bool bUseColumns = UsesColumnStorage();
+	for (int32 Index = 0; Index < Attributes.Num(); ++Index)
+	{
+		Attributes[Index].ColumnView.Bind(bUseColumns ? &Columns : nullptr, Index);
 	}
 }
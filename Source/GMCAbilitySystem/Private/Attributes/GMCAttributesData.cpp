@@ -0,0 +1,13 @@
+#include "Attributes/GMCAttributesData.h"
+
+#include "Attributes/GMCAttributeLayout.h"
+
+#if WITH_EDITOR
+void UGMCAttributesData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// Compiled layouts may have been built from this asset.
+	FGMCAttributeLayout::InvalidateCache();
+}
+#endif
@@ -12,6 +12,7 @@
 #include "Effects/GMCAbilityEffect.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "Net/UnrealNetwork.h"
+#include "UObject/CoreNet.h"
 
 // Sets default values for this component's properties
 UGMC_AbilitySystemComponent::UGMC_AbilitySystemComponent(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
@@ -20,6 +21,11 @@ UGMC_AbilitySystemComponent::UGMC_AbilitySystemComponent(const FObjectInitialize
 	// off to improve performance if you don't need them.
 	PrimaryComponentTick.bCanEverTick = true;
 	SetIsReplicatedByDefault(true);
+
+	ActiveEffectsData.Owner = this;
+
+	// Effects ended by their confirmation timeout stop being active, their IDs can be forgotten then.
+	ProcessedEffectIDs.IsEffectActive = [this](int32 EffectID) { return IsEffectActive(EffectID); };
 }
 
 FDelegateHandle UGMC_AbilitySystemComponent::AddFilteredTagChangeDelegate(const FGameplayTagContainer& Tags,
@@ -82,40 +88,97 @@ void UGMC_AbilitySystemComponent::RemoveAttributeChangeDelegate(FDelegateHandle
 	NativeAttributeChangeDelegate.Remove(Handle);
 }
 
+FDelegateHandle UGMC_AbilitySystemComponent::AddPreAttributeChangeDelegate(
+	const FGameplayPreAttributeChangedNative::FDelegate& Delegate)
+{
+	return NativePreAttributeChangeDelegate.Add(Delegate);
+}
+
+void UGMC_AbilitySystemComponent::RemovePreAttributeChangeDelegate(FDelegateHandle Handle)
+{
+	NativePreAttributeChangeDelegate.Remove(Handle);
+}
+
 void UGMC_AbilitySystemComponent::BindReplicationData()
 {
 	// Attribute Binds
 	//
 	InstantiateAttributes();
 
-	// We sort our attributes alphabetically by tag so that it's deterministic.
-	for (auto& AttributeForBind : BoundAttributes.Attributes)
+	// Modifiers applied without an effect, per channel of the bound attributes. Rolled back with the channels they go
+	// into, which are rebuilt from them and the effects.
+	RolledBackUnownedModifiers.Init(0.f, BoundAttributes.Attributes.Num() * FGMCAttributeModifierAggregator::NumChannels);
+	for (int32 Slot = 0; Slot < BoundAttributes.Attributes.Num(); ++Slot)
 	{
-		GMCMovementComponent->BindSinglePrecisionFloat(AttributeForBind.BaseValue,
-			EGMC_PredictionMode::ServerAuth_Output_ClientValidated,
-			EGMC_CombineMode::CombineIfUnchanged,
-			EGMC_SimulationMode::Periodic_Output,
-			EGMC_InterpolationFunction::TargetValue);
-		
-		GMCMovementComponent->BindSinglePrecisionFloat(AttributeForBind.Value,
-			EGMC_PredictionMode::ServerAuth_Output_ClientValidated,
-			EGMC_CombineMode::CombineIfUnchanged,
-			EGMC_SimulationMode::Periodic_Output,
-			EGMC_InterpolationFunction::TargetValue);
+		for (const EModifierType ModifierType : {EModifierType::Add, EModifierType::Multiply, EModifierType::Divide})
+		{
+			if (float* UnownedModifier = FindRolledBackUnownedModifier(Slot, ModifierType))
+			{
+				GMCMovementComponent->BindSinglePrecisionFloat(*UnownedModifier,
+					EGMC_PredictionMode::ServerAuth_Output_ClientValidated,
+					EGMC_CombineMode::CombineIfUnchanged,
+					EGMC_SimulationMode::None,
+					EGMC_InterpolationFunction::TargetValue);
+			}
+		}
+	}
+
+	// Bound attributes are in layout order, which is deterministic.
+	// With column storage, the Ref accessors point to the columns, which is what gets bound.
+	for (int32 Slot = 0; Slot < BoundAttributes.Attributes.Num(); ++Slot)
+	{
+		const FAttribute& AttributeForBind = BoundAttributes.Attributes[Slot];
+		const FGMCAttributeLayoutEntry& LayoutEntry = AttributeLayout->GetEntry(Slot);
 
-		GMCMovementComponent->BindSinglePrecisionFloat(AttributeForBind.AdditiveModifier,
+		// Quantized attributes are bound through their words below.
+		if (LayoutEntry.Quantization.IsQuantized()) continue;
+
+		GMCMovementComponent->BindSinglePrecisionFloat(AttributeForBind.BaseValueRef(),
 			EGMC_PredictionMode::ServerAuth_Output_ClientValidated,
 			EGMC_CombineMode::CombineIfUnchanged,
 			EGMC_SimulationMode::Periodic_Output,
 			EGMC_InterpolationFunction::TargetValue);
 		
-		GMCMovementComponent->BindSinglePrecisionFloat(AttributeForBind.MultiplyModifier,
+		GMCMovementComponent->BindSinglePrecisionFloat(AttributeForBind.ValueRef(),
 			EGMC_PredictionMode::ServerAuth_Output_ClientValidated,
 			EGMC_CombineMode::CombineIfUnchanged,
 			EGMC_SimulationMode::Periodic_Output,
 			EGMC_InterpolationFunction::TargetValue);
-		
-		GMCMovementComponent->BindSinglePrecisionFloat(AttributeForBind.DivisionModifier,
+
+		// Modifier channels which aren't used by this attribute are left out.
+		if (LayoutEntry.IsModifierChannelBound(EGMCAttributeModifierChannel::Additive))
+		{
+			GMCMovementComponent->BindSinglePrecisionFloat(AttributeForBind.AdditiveModifierRef(),
+				EGMC_PredictionMode::ServerAuth_Output_ClientValidated,
+				EGMC_CombineMode::CombineIfUnchanged,
+				EGMC_SimulationMode::Periodic_Output,
+				EGMC_InterpolationFunction::TargetValue);
+		}
+
+		if (LayoutEntry.IsModifierChannelBound(EGMCAttributeModifierChannel::Multiply))
+		{
+			GMCMovementComponent->BindSinglePrecisionFloat(AttributeForBind.MultiplyModifierRef(),
+				EGMC_PredictionMode::ServerAuth_Output_ClientValidated,
+				EGMC_CombineMode::CombineIfUnchanged,
+				EGMC_SimulationMode::Periodic_Output,
+				EGMC_InterpolationFunction::TargetValue);
+		}
+
+		if (LayoutEntry.IsModifierChannelBound(EGMCAttributeModifierChannel::Divide))
+		{
+			GMCMovementComponent->BindSinglePrecisionFloat(AttributeForBind.DivisionModifierRef(),
+				EGMC_PredictionMode::ServerAuth_Output_ClientValidated,
+				EGMC_CombineMode::CombineIfUnchanged,
+				EGMC_SimulationMode::Periodic_Output,
+				EGMC_InterpolationFunction::TargetValue);
+		}
+	}
+
+	QuantizedAttributeWords.Init(0, AttributeLayout ? AttributeLayout->GetNumQuantizedWords() : 0);
+	EncodeQuantizedAttributes();
+	for (int32& Word : QuantizedAttributeWords)
+	{
+		GMCMovementComponent->BindInt(Word,
 			EGMC_PredictionMode::ServerAuth_Output_ClientValidated,
 			EGMC_CombineMode::CombineIfUnchanged,
 			EGMC_SimulationMode::Periodic_Output,
@@ -143,6 +206,20 @@ void UGMC_AbilitySystemComponent::BindReplicationData()
 		EGMC_SimulationMode::Periodic_Output,
 		EGMC_InterpolationFunction::TargetValue);
 
+	// Holders of the active tags which moves can change, rolled back along with them. Effect holders are recounted
+	// from the local effects. Simulated proxies take their active tags as they come.
+	GMCMovementComponent->BindGameplayTagContainer(AddedActiveTags,
+		EGMC_PredictionMode::ServerAuth_Output_ClientValidated,
+		EGMC_CombineMode::CombineIfUnchanged,
+		EGMC_SimulationMode::None,
+		EGMC_InterpolationFunction::TargetValue);
+
+	GMCMovementComponent->BindGameplayTagContainer(MatchedActiveTags,
+		EGMC_PredictionMode::ServerAuth_Output_ClientValidated,
+		EGMC_CombineMode::CombineIfUnchanged,
+		EGMC_SimulationMode::None,
+		EGMC_InterpolationFunction::TargetValue);
+
 	// AbilityData Binds
 	// These are mostly client-inputs made to the server as Ability Requests
 	GMCMovementComponent->BindInt(AbilityData.AbilityActivationID,
@@ -203,6 +280,8 @@ void UGMC_AbilitySystemComponent::GenAncillaryTick(float DeltaTime, bool bIsComb
 	
 	ClearAbilityAndTaskData();
 	bInGMCTime = false;
+
+	EncodeQuantizedAttributes();
 }
 
 
@@ -287,17 +366,62 @@ bool UGMC_AbilitySystemComponent::HasGrantedAbilityTag(const FGameplayTag Gamepl
 
 void UGMC_AbilitySystemComponent::AddActiveTag(const FGameplayTag AbilityTag)
 {
+	if (!AbilityTag.IsValid() || AddedActiveTags.HasTagExact(AbilityTag)) return;
+
+	AddedActiveTags.AddTag(AbilityTag);
 	ActiveTags.AddTag(AbilityTag);
 }
 
 void UGMC_AbilitySystemComponent::RemoveActiveTag(const FGameplayTag AbilityTag)
 {
-	if (ActiveTags.HasTagExact(AbilityTag))
+	if (AddedActiveTags.RemoveTag(AbilityTag) && !IsActiveTagHeld(AbilityTag))
 	{
 		ActiveTags.RemoveTag(AbilityTag);
 	}
 }
 
+int32 UGMC_AbilitySystemComponent::GetActiveTagCount(const FGameplayTag GameplayTag) const
+{
+	return EffectGrantedTagCounts.FindRef(GameplayTag) + (AddedActiveTags.HasTagExact(GameplayTag) ? 1 : 0) +
+		(MatchedActiveTags.HasTagExact(GameplayTag) ? 1 : 0);
+}
+
+bool UGMC_AbilitySystemComponent::IsActiveTagHeld(const FGameplayTag& Tag) const
+{
+	return EffectGrantedTagCounts.Contains(Tag) || AddedActiveTags.HasTagExact(Tag) || MatchedActiveTags.HasTagExact(Tag);
+}
+
+void UGMC_AbilitySystemComponent::ReconcileActiveTags()
+{
+	// Nothing rewrote the tags most of the time.
+	bool bInSync = true;
+	for (auto It = ActiveTags.CreateConstIterator(); bInSync && It; ++It)
+	{
+		bInSync = IsActiveTagHeld(*It);
+	}
+	for (auto It = AddedActiveTags.CreateConstIterator(); bInSync && It; ++It)
+	{
+		bInSync = ActiveTags.HasTagExact(*It);
+	}
+	for (auto It = MatchedActiveTags.CreateConstIterator(); bInSync && It; ++It)
+	{
+		bInSync = ActiveTags.HasTagExact(*It);
+	}
+	for (auto It = EffectGrantedTagCounts.CreateConstIterator(); bInSync && It; ++It)
+	{
+		bInSync = ActiveTags.HasTagExact(It.Key());
+	}
+	if (bInSync) return;
+
+	FGameplayTagContainer HeldTags = AddedActiveTags;
+	HeldTags.AppendTags(MatchedActiveTags);
+	for (const TPair<FGameplayTag, int32>& EffectGrantedTag : EffectGrantedTagCounts)
+	{
+		HeldTags.AddTag(EffectGrantedTag.Key);
+	}
+	ActiveTags = MoveTemp(HeldTags);
+}
+
 bool UGMC_AbilitySystemComponent::HasActiveTag(const FGameplayTag GameplayTag) const
 {
 	return ActiveTags.HasTag(GameplayTag);
@@ -551,10 +675,13 @@ TMap<FGameplayTag, float> UGMC_AbilitySystemComponent::GetCooldownsForInputTag(c
 void UGMC_AbilitySystemComponent::MatchTagToBool(const FGameplayTag& InTag, bool MatchedBool){
 	if(!InTag.IsValid()) return;
 	if(MatchedBool){
-		AddActiveTag(InTag);
+		if (!MatchedActiveTags.HasTagExact(InTag)){
+			MatchedActiveTags.AddTag(InTag);
+			ActiveTags.AddTag(InTag);
+		}
 	}
-	else{
-		RemoveActiveTag(InTag);
+	else if (MatchedActiveTags.RemoveTag(InTag) && !IsActiveTagHeld(InTag)){
+		ActiveTags.RemoveTag(InTag);
 	}
 }
 
@@ -571,8 +698,30 @@ void UGMC_AbilitySystemComponent::GenPredictionTick(float DeltaTime)
 {
 	bJustTeleported = false;
 	ActionTimer += DeltaTime;
+
+	DecodeQuantizedAttributes();
+
+	if (!HasAuthority())
+	{
+		ReconcileActiveTags();
+	}
+
+	// Bound columns may have been rewritten by the GMC (replay, correction), refresh every value in one pass.
+	if (BoundAttributes.UsesColumnStorage())
+	{
+		BoundAttributes.CalculateValues();
+	}
+
+	// Clients replay moves after a correction, which rewrites bound attributes without going through our mutation paths.
+	// The server is never corrected, so it only tracks what it modifies itself.
+	if (!HasAuthority())
+	{
+		MarkRewrittenBoundAttributesChanged();
+	}
 	
 	ApplyStartingEffects();
+
+	TickAttributeRegen(DeltaTime);
 	
 	TickActiveAbilities(DeltaTime);
 	
@@ -587,11 +736,31 @@ void UGMC_AbilitySystemComponent::GenPredictionTick(float DeltaTime)
 
 	SendTaskDataToActiveAbility(true);
 
-	
+	EncodeQuantizedAttributes();
+
+	if (!HasAuthority())
+	{
+		for (int32 Slot = 0; Slot < PredictedBoundValues.Num(); ++Slot)
+		{
+			PredictedBoundValues[Slot] = BoundAttributes.Attributes[Slot].ValueRef();
+		}
+	}
+
+	RecordAttributeHistory();
 }
 
 void UGMC_AbilitySystemComponent::GenSimulationTick(float DeltaTime)
 {
+	DecodeQuantizedAttributes();
+
+	// Simulated bound attributes and tags come straight from the GMC.
+	MarkAllBoundAttributesChanged();
+
+	if (BoundAttributes.UsesColumnStorage())
+	{
+		BoundAttributes.CalculateValues();
+	}
+
 	CheckActiveTagsChanged();
 	CheckAttributeChanged();
 	
@@ -631,116 +800,140 @@ void UGMC_AbilitySystemComponent::InstantiateAttributes()
 {
 	BoundAttributes = FGMCAttributeSet();
 	UnBoundAttributes = FGMCUnboundAttributeSet();
+
+	// Static data (tags, clamps, regen, ordering, clamp graph) is compiled once and shared with every component using
+	// the same data assets, we only create the numeric state here.
+	AttributeLayout = FGMCAttributeLayout::Get(AttributeDataAssets);
+	++AttributeLayoutSerial;
+	MarkAttributeLookupDirty();
 	if (AttributeDataAssets.IsEmpty()) {
 		return;
 	}
 
-	// The key is the attribute which clamps, the value is the attribute being clamped.
-	TMap<FGameplayTag, FGameplayTagContainer> AllAttributeClamps;
+	// FFastArraySerializer will duplicate all attributes on first replication if we
+	// add the unbound attributes on the clients as well.
+	const bool bInstantiateUnbound = GetOwnerRole() == ROLE_Authority || GetNetMode() == NM_Standalone;
+
+	BoundAttributes.Attributes.Reserve(AttributeLayout->GetNumBound());
+	for (const FGMCAttributeLayoutEntry& Entry : AttributeLayout->GetEntries())
+	{
+		OnAttributeValueChangedDelegateMap.Add(Entry.Tag, FOnAttributeValueChanged());
+		if (!Entry.bIsGMCBound && !bInstantiateUnbound) continue;
 
-	// Loop through each of the data assets inputted into the component to create new attributes.
-	for(UGMCAttributesData* AttributeDataAsset : AttributeDataAssets){
+		FAttribute NewAttribute;
+		NewAttribute.Tag = Entry.Tag;
+		NewAttribute.BaseValue = Entry.DefaultValue;
+		NewAttribute.Clamp = Entry.Clamp;
+		NewAttribute.Clamp.AbilityComponent = this;
+		NewAttribute.bIsGMCBound = Entry.bIsGMCBound;
+		NewAttribute.Init();
 
-		// Avoid crashing in an editor preview if we're actually editing the ability component's attribute table.
-		if (!AttributeDataAsset) {
-			continue;
+		if (Entry.bIsGMCBound)
+		{
+			// The layout is already in binding order.
+			BoundAttributes.Attributes.Add(NewAttribute);
 		}
-		
-		for(const FAttributeData& AttributeData : AttributeDataAsset->AttributeData){
-			FAttribute NewAttribute;
-			NewAttribute.Tag = AttributeData.AttributeTag;
-			NewAttribute.RegenAttributeTag = AttributeData.RegenAttributeTag;
-			NewAttribute.RegenBlockingTags = AttributeData.RegenBlockingTags;
-			NewAttribute.BaseValue = AttributeData.DefaultValue;
-			NewAttribute.Clamp = AttributeData.Clamp;
-			NewAttribute.Clamp.AbilityComponent = this;
-			NewAttribute.bIsGMCBound = AttributeData.bGMCBound;
-			NewAttribute.Init();
-
-			// Populate clamping.
-			if (NewAttribute.Clamp.MaxAttributeTag.IsValid())
-			{
-				FGameplayTagContainer* ExistingContainer = AllAttributeClamps.Find(NewAttribute.Clamp.MaxAttributeTag);
-				if (ExistingContainer)
-				{
-					ExistingContainer->AddTag(NewAttribute.Tag);
-				}
-				else
-				{
-					AllAttributeClamps.Add(NewAttribute.Clamp.MaxAttributeTag, FGameplayTagContainer(NewAttribute.Tag));
-				}
-			}
-			if (NewAttribute.Clamp.MinAttributeTag.IsValid())
-			{
-				FGameplayTagContainer* ExistingContainer = AllAttributeClamps.Find(NewAttribute.Clamp.MinAttributeTag);
-				if (ExistingContainer)
-				{
-					ExistingContainer->AddTag(NewAttribute.Tag);
-				}
-				else
-				{
-					AllAttributeClamps.Add(NewAttribute.Clamp.MinAttributeTag, FGameplayTagContainer(NewAttribute.Tag));
-				}
-			}
-
-			OnAttributeValueChangedDelegateMap.Add(NewAttribute.Tag, FOnAttributeValueChanged());
-			
-			if(AttributeData.bGMCBound){
-				BoundAttributes.AddAttribute(NewAttribute);
-			}
-			else if (GetOwnerRole() == ROLE_Authority || GetNetMode() == NM_Standalone) {
-				NewAttribute.AbilitySystem = this;
-				// FFastArraySerializer will duplicate all attributes on first replication if we
-				// add the attributes on the clients as well.
-				UnBoundAttributes.AddAttribute(NewAttribute);
-				
-			}
-			
-			if (!AttributeData.bGMCBound) {
-				// Initiate old unbound attributes
-				OldUnBoundAttributes.AddAttribute(NewAttribute);
-			}
+		else
+		{
+			NewAttribute.AbilitySystem = this;
+			UnBoundAttributes.AddAttribute(NewAttribute);
 		}
 	}
 
 	// After all attributes are initialized, calc their values which will primarily apply their Clamps.
-	// We also update foreign clamps references.
 	for (FAttribute& Attribute : BoundAttributes.Attributes)
 	{
 		Attribute.CalculateValue();
-		FGameplayTagContainer* AttributesClamped = AllAttributeClamps.Find(Attribute.Tag);
-		if (AttributesClamped)
-		{
-			Attribute.AttributesClampedBySelf = *AttributesClamped;
-		}
 	}
 
 	// After all attributes are initialized, calc their values which will primarily apply their Clamps.
-	// We also update foreign clamps references.
 	for (FAttribute& Attribute : UnBoundAttributes.Items)
 	{
 		Attribute.CalculateValue();
-		FGameplayTagContainer* AttributesClamped = AllAttributeClamps.Find(Attribute.Tag);
-		if (AttributesClamped)
-		{
-			Attribute.AttributesClampedBySelf = *AttributesClamped;
-		}
 		UnBoundAttributes.MarkItemDirty(Attribute);
 	}
 	UnBoundAttributes.MarkArrayDirty();
-	
 
-	for (const FAttribute& Attribute : OldUnBoundAttributes.Items)
+	// Must happen before binding, the columns are never reallocated afterwards.
+	if (bUseAttributeColumnStorage)
 	{
-		Attribute.CalculateValue();
+		BoundAttributes.EnableColumnStorage();
+	}
+
+	PreviousBoundValues.Reset(BoundAttributes.Attributes.Num());
+	for (const FAttribute& Attribute : BoundAttributes.Attributes)
+	{
+		PreviousBoundValues.Add(Attribute.Value);
 	}
+	PredictedBoundValues = PreviousBoundValues;
+	ChangedBoundAttributes.Init(false, BoundAttributes.Attributes.Num());
+	bAnyBoundAttributeChanged = false;
 
-	OldBoundAttributes = BoundAttributes;
+	ModifierAggregator.Init(AttributeLayout->Num());
+
+	// Rebuilt for the new layout on the next regen tick.
+	BlockedRegens.Reset();
+
+	AttributeHistory.Init(bRecordAttributeHistory ? FMath::Max(AttributeHistoryCapacity, 2) : 0, AttributeLayout->Num());
+
+	RebuildAttributeLookup();
+}
+
+void UGMC_AbilitySystemComponent::RebuildAttributeLookup() const
+{
+	bAttributeLookupDirty = false;
+	UnboundItemIndices.Reset();
+	if (!AttributeLayout) return;
+
+	const int32 NumBound = AttributeLayout->GetNumBound();
+	UnboundItemIndices.Init(INDEX_NONE, AttributeLayout->GetNumUnbound());
+	for (int32 Index = 0; Index < UnBoundAttributes.Items.Num(); ++Index)
+	{
+		const int32 Slot = AttributeLayout->FindSlot(UnBoundAttributes.Items[Index].Tag);
+		if (Slot >= NumBound && UnboundItemIndices[Slot - NumBound] == INDEX_NONE)
+		{
+			UnboundItemIndices[Slot - NumBound] = Index;
+		}
+	}
+}
+
+int32 UGMC_AbilitySystemComponent::GetAttributeNode(const FGMCAttributeHandle& Handle) const
+{
+	return Handle.IsValid() ? Handle.Index : INDEX_NONE;
+}
+
+int32 UGMC_AbilitySystemComponent::GetUnboundItemIndex(int32 Node) const
+{
+	if (!AttributeLayout) return INDEX_NONE;
+
+	if (bAttributeLookupDirty)
+	{
+		RebuildAttributeLookup();
+	}
+
+	const int32 UnboundSlot = Node - AttributeLayout->GetNumBound();
+	return UnboundItemIndices.IsValidIndex(UnboundSlot) ? UnboundItemIndices[UnboundSlot] : INDEX_NONE;
+}
+
+const FAttribute* UGMC_AbilitySystemComponent::GetAttributeByNode(int32 Node) const
+{
+	if (!AttributeLayout || Node == INDEX_NONE) return nullptr;
+
+	if (Node < AttributeLayout->GetNumBound())
+	{
+		return BoundAttributes.Attributes.IsValidIndex(Node) ? &BoundAttributes.Attributes[Node] : nullptr;
+	}
+
+	const int32 ItemIndex = GetUnboundItemIndex(Node);
+	return UnBoundAttributes.Items.IsValidIndex(ItemIndex) ? &UnBoundAttributes.Items[ItemIndex] : nullptr;
 }
 
 void UGMC_AbilitySystemComponent::SetStartingTags()
 {
-	ActiveTags.AppendTags(StartingTags);
+	for (const FGameplayTag& Tag : StartingTags)
+	{
+		AddActiveTag(Tag);
+	}
 }
 
 void UGMC_AbilitySystemComponent::CheckActiveTagsChanged()
@@ -793,15 +986,43 @@ void UGMC_AbilitySystemComponent::CheckActiveTagsChanged()
 
 
 void UGMC_AbilitySystemComponent::CheckAttributeChanged() {
-	// Check Bound Attributes
-	for (int i = 0; i < BoundAttributes.Attributes.Num(); i++)
+	if (!bAnyBoundAttributeChanged) return;
+	bAnyBoundAttributeChanged = false;
+
+	// Check Bound Attributes, only the ones modified since the last check.
+	for (TConstSetBitIterator<> It(ChangedBoundAttributes); It; ++It)
+	{
+		const int32 Slot = It.GetIndex();
+		if (!BoundAttributes.Attributes.IsValidIndex(Slot) || !PreviousBoundValues.IsValidIndex(Slot)) continue;
+
+		const FAttribute& Attribute = BoundAttributes.Attributes[Slot];
+		float& OldValue = PreviousBoundValues[Slot];
+		if (Attribute.Value != OldValue)
+		{
+			OnAttributeChanged.Broadcast(Attribute.Tag, OldValue, Attribute.Value);
+			OldValue = Attribute.Value;
+		}
+	}
+	ChangedBoundAttributes.SetRange(0, ChangedBoundAttributes.Num(), false);
+}
+
+void UGMC_AbilitySystemComponent::MarkAllBoundAttributesChanged()
+{
+	if (ChangedBoundAttributes.Num() == 0) return;
+
+	ChangedBoundAttributes.SetRange(0, ChangedBoundAttributes.Num(), true);
+	bAnyBoundAttributeChanged = true;
+}
+
+void UGMC_AbilitySystemComponent::MarkRewrittenBoundAttributesChanged()
+{
+	const int32 NumSlots = FMath::Min(PredictedBoundValues.Num(), ChangedBoundAttributes.Num());
+	for (int32 Slot = 0; Slot < NumSlots; ++Slot)
 	{
-		FAttribute& Attribute = BoundAttributes.Attributes[i];
-		FAttribute& OldAttribute = OldBoundAttributes.Attributes[i];
-		if (Attribute.Value != OldAttribute.Value)
+		if (BoundAttributes.Attributes[Slot].ValueRef() != PredictedBoundValues[Slot])
 		{
-			OnAttributeChanged.Broadcast(Attribute.Tag, OldAttribute.Value, Attribute.Value);
-			OldAttribute.Value = Attribute.Value;
+			ChangedBoundAttributes[Slot] = true;
+			bAnyBoundAttributeChanged = true;
 		}
 	}
 }
@@ -826,10 +1047,17 @@ void UGMC_AbilitySystemComponent::CleanupStaleAbilities()
 
 void UGMC_AbilitySystemComponent::TickActiveEffects(float DeltaTime)
 {
-	CheckRemovedEffects();
+	ReconcileReplicatedEffects();
+
+	if (!HasAuthority())
+	{
+		ProcessedEffectIDs.Expire(ActionTimer);
+	}
 	
 	TArray<int> CompletedActiveEffects;
 
+	TickTimedEffects();
+
 	// Tick Effects
 	for (const TPair<int, UGMCAbilityEffect*>& Effect : ActiveEffects)
 	{
@@ -839,20 +1067,29 @@ void UGMC_AbilitySystemComponent::TickActiveEffects(float DeltaTime)
 			CompletedActiveEffects.Push(Effect.Key);
 			continue;	
 		}
+
+		// Effects driven by timers only need to be collected once ended.
+		if (Effect.Value->TimerSerial != 0)
+		{
+			if (Effect.Value->bCompleted) {CompletedActiveEffects.Push(Effect.Key);}
+			continue;
+		}
 		
 		Effect.Value->Tick(DeltaTime);
 		if (Effect.Value->bCompleted) {CompletedActiveEffects.Push(Effect.Key);}
 
 		// Check for predicted effects that have not been server confirmed
-		if (!HasAuthority() &&
-			ProcessedEffectIDs.Contains(Effect.Key) &&
-			!ProcessedEffectIDs[Effect.Key] && Effect.Value->ClientEffectApplicationTime + ClientEffectApplicationTimeout < ActionTimer)
+		const bool* bServerConfirmed = HasAuthority() ? nullptr : ProcessedEffectIDs.Find(Effect.Key);
+		if (bServerConfirmed && !*bServerConfirmed && Effect.Value->ClientEffectApplicationTime + ClientEffectApplicationTimeout < ActionTimer)
 		{
 			UE_LOG(LogGMCAbilitySystem, Error, TEXT("Effect `%s` Not Confirmed By Server (ID: `%d`), Removing..."), *GetNameSafe(Effect.Value), Effect.Key);
 			Effect.Value->EndEffect();
 			CompletedActiveEffects.Push(Effect.Key);
 		}
 	}
+
+	TickLightweightEffects();
+	RemoveEndedLightweightEffects(CompletedActiveEffects);
 	
 	// Clean expired effects
 	for (const int EffectID : CompletedActiveEffects)
@@ -862,10 +1099,28 @@ void UGMC_AbilitySystemComponent::TickActiveEffects(float DeltaTime)
 			RPCClientEndEffect(EffectID);
 
 			// Only done on server as the property is replicated (changing it on client would cause the array to be in the wrong state).
-			ActiveEffectsData.RemoveAll([EffectID](const FActiveEffectsData& EffectData) {return EffectData.Data.EffectID == EffectID; });
+			ActiveEffectsData.Remove(EffectID);
 		}
 		
-		ActiveEffects.Remove(EffectID);
+		UGMCAbilityEffect* CompletedEffect = nullptr;
+		ActiveEffects.RemoveAndCopyValue(EffectID, CompletedEffect);
+
+		// Effects which ended while starting are left in the started state, they leave the index with the active effects.
+		if (IsValid(CompletedEffect) && CompletedEffect->CurrentState == EGMASEffectState::Started)
+		{
+			NotifyEffectStateChanged(EffectID, CompletedEffect->EffectData, EGMASEffectState::Started, EGMASEffectState::Ended);
+		}
+		ReleaseEffect(CompletedEffect);
+	}
+
+	// Timers of removed effects are skipped when due, only bother dropping them when they pile up.
+	if (!CompletedActiveEffects.IsEmpty() && EffectTimers.Num() > 4 * ActiveEffects.Num() + 16)
+	{
+		EffectTimers.RemoveAll([this](const FGMCEffectTimer& Timer)
+		{
+			const UGMCAbilityEffect* Effect = ActiveEffects.FindRef(Timer.EffectID);
+			return !IsValid(Effect) || Effect->TimerSerial != Timer.Serial;
+		});
 	}
 }
 
@@ -896,91 +1151,305 @@ void UGMC_AbilitySystemComponent::TickActiveCooldowns(float DeltaTime)
 	}
 }
 
-void UGMC_AbilitySystemComponent::OnRep_ActiveEffectsData()
+void UGMC_AbilitySystemComponent::TickAttributeRegen(float DeltaTime)
 {
-	for (FActiveEffectsData ActiveEffectData : ActiveEffectsData)
+	if (!AttributeLayout || DeltaTime <= 0.f) return;
+
+	const TConstArrayView<FGMCAttributeRegen> Regens = AttributeLayout->GetRegens();
+	if (Regens.IsEmpty()) return;
+
+	// Blocked regens can only change with the active tags, including when they're rolled back. Most of the time no
+	// blocking tag is active, and no regen needs to be checked against its own tags.
+	if (ActiveTags != RegenBlockingCheckedTags || BlockedRegens.Num() != Regens.Num())
 	{
-		if (ActiveEffectData.Data.EffectID == 0 || !IsValid(ActiveEffectData.Class)) continue;
-		
-		if (!ProcessedEffectIDs.Contains(ActiveEffectData.Data.EffectID))
+		RegenBlockingCheckedTags = ActiveTags;
+		bAnyRegenBlocked = ActiveTags.HasAny(AttributeLayout->GetAllRegenBlockingTags());
+		BlockedRegens.Init(false, Regens.Num());
+		for (int32 Index = 0; bAnyRegenBlocked && Index < Regens.Num(); ++Index)
 		{
-			UGMCAbilityEffect* EffectCDO = DuplicateObject(ActiveEffectData.Class->GetDefaultObject<UGMCAbilityEffect>(), this);
-			FGMCAbilityEffectData EffectData = ActiveEffectData.Data;
-			ApplyAbilityEffect(EffectCDO, EffectData);
-			ProcessedEffectIDs.Add(EffectData.EffectID, true);
-			UE_LOG(LogGMCAbilitySystem, VeryVerbose, TEXT("Replicated Effect: %d"), ActiveEffectData.Data.EffectID);
+			BlockedRegens[Index] = ActiveTags.HasAny(AttributeLayout->GetEntry(Regens[Index].Slot).RegenBlockingTags);
 		}
-		
-		ProcessedEffectIDs[ActiveEffectData.Data.EffectID] = true;
+	}
+
+	FAttributeChangeBatch Batch;
+	for (int32 Index = 0; Index < Regens.Num(); ++Index)
+	{
+		if (bAnyRegenBlocked && BlockedRegens[Index]) continue;
+
+		const FGMCAttributeRegen& Regen = Regens[Index];
+		const FAttribute* RateAttribute = GetAttributeByNode(Regen.RateSlot);
+		const FAttribute* Attribute = GetAttributeByNode(Regen.Slot);
+		if (!RateAttribute || !Attribute || RateAttribute->Value == 0.f) continue;
+
+		const float OldValue = Attribute->Value;
+		Attribute->SetBaseValue(Attribute->BaseValueRef() + RateAttribute->Value * DeltaTime);
+		Attribute->CalculateValue();
+
+		// Attributes already at their clamp don't change, and don't need to be broadcast or re-clamped.
+		if (Attribute->Value != OldValue)
+		{
+			Batch.Add({Regen.Slot, OldValue});
+		}
+	}
+
+	if (Batch.IsEmpty()) return;
+
+	ResolveAttributeClamps(Batch);
+	CommitAttributeChanges(Batch);
+}
+
+void UGMC_AbilitySystemComponent::RecordAttributeHistory()
+{
+	const TArrayView<float> Values = AttributeHistory.Record(ActionTimer, ActiveTags);
+	for (int32 Slot = 0; Slot < Values.Num(); ++Slot)
+	{
+		// Unbound attributes which haven't replicated yet are recorded as 0.
+		const FAttribute* Attribute = GetAttributeByNode(Slot);
+		Values[Slot] = Attribute ? Attribute->Value : 0.f;
 	}
 }
 
-void UGMC_AbilitySystemComponent::CheckRemovedEffects()
+namespace
 {
-	for (TPair<int, UGMCAbilityEffect*> Effect : ActiveEffects)
+	// Effect times, sent in the fixed point periods are counted in so that both sides count the same period ticks.
+	void SerializeEffectTime(FArchive& Ar, double& Time, double BaseTime = 0)
 	{
-		// Ensure this effect has been processed locally
-		if (!ProcessedEffectIDs.Contains(Effect.Key)){return;}
+		const int64 FixedTime = FGMCAbilityEffectData::ToPeriodFixedTime(Time) - FGMCAbilityEffectData::ToPeriodFixedTime(BaseTime);
 
-		// Ensure this effect has already been confirmed by the server so that if it's now missing,
-		// it means the server removed it
-		if (!ProcessedEffectIDs[Effect.Key]){return;}
-		
-		if (!ActiveEffectsData.ContainsByPredicate([Effect](const FActiveEffectsData& EffectData) {return EffectData.Data.EffectID == Effect.Key;}))
+		// Zigzag encoded so that small values of either sign take few bytes.
+		uint64 Encoded = (static_cast<uint64>(FixedTime) << 1) ^ static_cast<uint64>(FixedTime >> 63);
+		uint32 Low = static_cast<uint32>(Encoded);
+		uint32 High = static_cast<uint32>(Encoded >> 32);
+		Ar.SerializeIntPacked(Low);
+		Ar.SerializeIntPacked(High);
+
+		if (Ar.IsLoading())
 		{
-			RemoveActiveAbilityEffect(Effect.Value);
+			Encoded = (static_cast<uint64>(High) << 32) | Low;
+			const int64 Decoded = static_cast<int64>(Encoded >> 1) ^ -static_cast<int64>(Encoded & 1);
+			Time = (Decoded + FGMCAbilityEffectData::ToPeriodFixedTime(BaseTime)) / FGMCAbilityEffectData::PeriodTimeResolution;
 		}
 	}
 }
 
-void UGMC_AbilitySystemComponent::AddPendingEffectApplications(FGMCOuterApplicationWrapper& Wrapper, float ClientGraceTime) {
-	check(HasAuthority())
+bool FActiveEffectsData::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	UObject* ClassObject = Class.Get();
+	Ar << ClassObject;
 
-	APawn* PawnOwner = Cast<APawn>(GetOwner());
-	bool bUseGraceTime = ClientGraceTime > 0.f && IsValid(PawnOwner) && IsValid(Cast<APlayerController>(PawnOwner->GetController()));
+	uint8 bLightweightBit = bLightweight;
+	Ar.SerializeBits(&bLightweightBit, 1);
 
-	Wrapper.ClientGraceTimeRemaining = bUseGraceTime ? ClientGraceTime : -10000.f;
-	Wrapper.LateApplicationID = GenerateLateApplicationID();
+	uint32 EffectID = static_cast<uint32>(Data.EffectID);
+	Ar.SerializeIntPacked(EffectID);
 
-	PendingApplicationServer.Add(Wrapper);
-	if (bUseGraceTime)
+	// Fields left out of the overrides are the class defaults.
+	const UClass* EffectClass = Cast<UClass>(ClassObject);
+	const UGMCAbilityEffect* EffectCDO = EffectClass && EffectClass->IsChildOf(UGMCAbilityEffect::StaticClass()) ? EffectClass->GetDefaultObject<UGMCAbilityEffect>() : nullptr;
+	static const FGMCAbilityEffectData NoDefaults;
+	const FGMCAbilityEffectData& Defaults = EffectCDO ? EffectCDO->EffectData : NoDefaults;
+
+	if (Ar.IsLoading())
 	{
-		RPCClientAddPendingEffectApplication(Wrapper);
+		Class = const_cast<UClass*>(EffectClass);
+		bLightweight = bLightweightBit != 0;
+		Data = Defaults;
+		Data.EffectID = static_cast<int>(EffectID);
 	}
-}
 
+	// The end time is usually close to the start time.
+	SerializeEffectTime(Ar, Data.StartTime);
+	SerializeEffectTime(Ar, Data.EndTime, Data.StartTime);
 
-void UGMC_AbilitySystemComponent::RPCClientAddPendingEffectApplication_Implementation(
-		FGMCOuterApplicationWrapper Wrapper) {
-	PendingApplicationClient.Add(Wrapper);
-}
+	// Overrides can't be read without the class defaults, they're sized so that an entry whose class isn't loaded yet
+	// can skip them. The fast array serializes such an entry again once its class resolves, as a change.
+	if (Ar.IsSaving())
+	{
+		FNetBitWriter OverridesWriter(Map, 0);
+		bOutSuccess = Data.NetSerializeOverrides(OverridesWriter, Map, Defaults);
+		uint32 NumOverrideBits = static_cast<uint32>(OverridesWriter.GetNumBits());
+		Ar.SerializeIntPacked(NumOverrideBits);
+		Ar.SerializeBits(OverridesWriter.GetData(), NumOverrideBits);
+		return true;
+	}
 
+	uint32 NumOverrideBits = 0;
+	Ar.SerializeIntPacked(NumOverrideBits);
 
+	// Effects don't come with that much data, this is a corrupted stream.
+	if (NumOverrideBits > MaxOverrideBits)
+	{
+		Ar.SetError();
+		bOutSuccess = false;
+		return false;
+	}
 
-void UGMC_AbilitySystemComponent::ServerHandlePendingEffect(float DeltaTime) {
-	if (!HasAuthority()) {
-		return;
+	TArray<uint8> OverrideBytes;
+	OverrideBytes.SetNumZeroed(FMath::DivideAndRoundUp<uint32>(NumOverrideBits, 8));
+	Ar.SerializeBits(OverrideBytes.GetData(), NumOverrideBits);
+
+	// Left pending, the effect is applied once the entry comes again with its class.
+	if (!EffectCDO)
+	{
+		bOutSuccess = !Ar.IsError();
+		return true;
 	}
 
-	FGMCAcknowledgeId& AckId =	AcknowledgeId.GetMutable<FGMCAcknowledgeId>();
+	FNetBitReader OverridesReader(Map, OverrideBytes.GetData(), NumOverrideBits);
+	bOutSuccess = Data.NetSerializeOverrides(OverridesReader, Map, Defaults) && !OverridesReader.IsError();
+	return true;
+}
 
+// Replicated entries are only noted here, the effects are reconciled with them during the next ancillary tick.
+void FActiveEffectsData::NoteReplicatedEffectChange(const FActiveEffectsDataArray& InArraySerializer) const
+{
+	if (InArraySerializer.Owner && Data.EffectID != 0)
+	{
+		InArraySerializer.Owner->ReplicatedEffectChanges.Add(Data.EffectID);
+	}
+}
 
-	for (int i = PendingApplicationServer.Num() - 1; i >= 0; i--) {
-		FGMCOuterApplicationWrapper& Wrapper = PendingApplicationServer[i];
+void FActiveEffectsData::PostReplicatedAdd(const FActiveEffectsDataArray& InArraySerializer)
+{
+	NoteReplicatedEffectChange(InArraySerializer);
+}
 
-		if (Wrapper.ClientGraceTimeRemaining <= 0.f || AckId.Id.Contains(Wrapper.LateApplicationID)) {
+void FActiveEffectsData::PostReplicatedChange(const FActiveEffectsDataArray& InArraySerializer)
+{
+	// Entries aren't modified once added, but a changed entry is still an effect the server has.
+	NoteReplicatedEffectChange(InArraySerializer);
+}
 
-			switch (Wrapper.Type) {
-				case EGMC_AddEffect: {
-					const FGMCOuterEffectAdd& Data = Wrapper.OuterApplicationData.Get<FGMCOuterEffectAdd>();
-					UGMCAbilityEffect* AbilityEffect = DuplicateObject(Data.EffectClass->GetDefaultObject<UGMCAbilityEffect>(), this);
-					AbilityEffect->EffectData.EffectID = Wrapper.LateApplicationID;
-					FGMCAbilityEffectData EffectData = Data.InitializationData.IsValid() ?  Data.InitializationData : AbilityEffect->EffectData;
-					UGMCAbilityEffect* FX = ApplyAbilityEffect(AbilityEffect, EffectData);
-					// If the client grace time remaining is below below -1000, it means that it was an outer activation with no client grace time.
-					// In other words, we expect the server to apply the effect without ever telling the client to apply it.
+void FActiveEffectsData::PreReplicatedRemove(const FActiveEffectsDataArray& InArraySerializer)
+{
+	NoteReplicatedEffectChange(InArraySerializer);
+}
+
+void UGMC_AbilitySystemComponent::OnActiveEffectDataReplicated(const FActiveEffectsData& ActiveEffectData)
+{
+	// Entries whose class isn't loaded yet are replicated again once it is.
+	if (ActiveEffectData.Data.EffectID == 0 || !IsValid(ActiveEffectData.Class)) return;
+
+	// Effects processed long ago are forgotten, but they're still recognized while active.
+	if (!ProcessedEffectIDs.Contains(ActiveEffectData.Data.EffectID) && !IsEffectIDInUse(ActiveEffectData.Data.EffectID))
+	{
+		FGMCAbilityEffectData EffectData = ActiveEffectData.Data;
+		const TSharedPtr<const FGMCLightweightEffectSpec> LightweightSpec = ActiveEffectData.bLightweight ? FGMCLightweightEffectSpec::Get(ActiveEffectData.Class) : nullptr;
+		if (LightweightSpec)
+		{
+			ApplyLightweightEffect(LightweightSpec.ToSharedRef(), EffectData);
+		}
+		else
+		{
+			UGMCAbilityEffect* EffectCDO = AcquireEffect(ActiveEffectData.Class);
+			ApplyAbilityEffect(EffectCDO, EffectData);
+		}
+		UE_LOG(LogGMCAbilitySystem, VeryVerbose, TEXT("Replicated Effect: %d"), ActiveEffectData.Data.EffectID);
+	}
+
+	ProcessedEffectIDs.Add(ActiveEffectData.Data.EffectID, true, ActionTimer);
+}
+
+void UGMC_AbilitySystemComponent::ReconcileReplicatedEffects()
+{
+	if (ReplicatedEffectChanges.IsEmpty()) return;
+
+	// An entry added then removed before we got here is just removed, and the other way around.
+	TArray<int> ChangedEffectIDs = MoveTemp(ReplicatedEffectChanges);
+	ReplicatedEffectChanges.Reset();
+	ChangedEffectIDs.Sort();
+
+	// Replicated entries sorted by ID, walked along with the changed IDs.
+	TArray<const FActiveEffectsData*, TInlineAllocator<32>> ReplicatedEffects;
+	ReplicatedEffects.Reserve(ActiveEffectsData.Items.Num());
+	for (const FActiveEffectsData& ActiveEffectData : ActiveEffectsData.Items)
+	{
+		ReplicatedEffects.Add(&ActiveEffectData);
+	}
+	ReplicatedEffects.Sort([](const FActiveEffectsData& A, const FActiveEffectsData& B) { return A.Data.EffectID < B.Data.EffectID; });
+
+	FLightweightEffectScope Scope(*this);
+	int32 ReplicatedIndex = 0;
+	for (int32 Index = 0; Index < ChangedEffectIDs.Num(); ++Index)
+	{
+		const int EffectID = ChangedEffectIDs[Index];
+		if (Index > 0 && ChangedEffectIDs[Index - 1] == EffectID) continue;
+
+		while (ReplicatedIndex < ReplicatedEffects.Num() && ReplicatedEffects[ReplicatedIndex]->Data.EffectID < EffectID)
+		{
+			++ReplicatedIndex;
+		}
+
+		if (ReplicatedIndex < ReplicatedEffects.Num() && ReplicatedEffects[ReplicatedIndex]->Data.EffectID == EffectID)
+		{
+			OnActiveEffectDataReplicated(*ReplicatedEffects[ReplicatedIndex]);
+			continue;
+		}
+
+		// The server only removes effects it replicated, which confirmed them here.
+		RemoveActiveAbilityEffectByID(EffectID);
+	}
+}
+
+void UGMC_AbilitySystemComponent::AddPendingEffectApplications(FGMCOuterApplicationWrapper& Wrapper, float ClientGraceTime) {
+	check(HasAuthority())
+
+	APawn* PawnOwner = Cast<APawn>(GetOwner());
+	bool bUseGraceTime = ClientGraceTime > 0.f && IsValid(PawnOwner) && IsValid(Cast<APlayerController>(PawnOwner->GetController()));
+
+	Wrapper.ClientGraceTimeRemaining = bUseGraceTime ? ClientGraceTime : -10000.f;
+	Wrapper.LateApplicationID = GenerateLateApplicationID();
+
+	PendingApplicationServer.Add(Wrapper);
+	if (bUseGraceTime)
+	{
+		RPCClientAddPendingEffectApplication(Wrapper);
+	}
+}
+
+
+void UGMC_AbilitySystemComponent::RPCClientAddPendingEffectApplication_Implementation(
+		FGMCOuterApplicationWrapper Wrapper) {
+	PendingApplicationClient.Add(Wrapper);
+}
+
+
+
+void UGMC_AbilitySystemComponent::ServerHandlePendingEffect(float DeltaTime) {
+	if (!HasAuthority()) {
+		return;
+	}
+
+	FGMCAcknowledgeId& AckId =	AcknowledgeId.GetMutable<FGMCAcknowledgeId>();
+
+
+	for (int i = PendingApplicationServer.Num() - 1; i >= 0; i--) {
+		FGMCOuterApplicationWrapper& Wrapper = PendingApplicationServer[i];
+
+		if (Wrapper.ClientGraceTimeRemaining <= 0.f || AckId.Id.Contains(Wrapper.LateApplicationID)) {
+
+			switch (Wrapper.Type) {
+				case EGMC_AddEffect: {
+					const FGMCOuterEffectAdd& Data = Wrapper.OuterApplicationData.Get<FGMCOuterEffectAdd>();
+					const TSharedPtr<const FGMCLightweightEffectSpec> LightweightSpec = Data.InitializationData.IsValid() ? nullptr : FGMCLightweightEffectSpec::Get(Data.EffectClass);
+					FGameplayTag EffectTag;
+					if (LightweightSpec) {
+						FGMCAbilityEffectData EffectData;
+						EffectData.EffectID = Wrapper.LateApplicationID;
+						ApplyLightweightEffect(LightweightSpec.ToSharedRef(), EffectData);
+						EffectTag = LightweightSpec->Data.EffectTag;
+					}
+					else {
+						UGMCAbilityEffect* AbilityEffect = AcquireEffect(Data.EffectClass);
+						AbilityEffect->EffectData.EffectID = Wrapper.LateApplicationID;
+						FGMCAbilityEffectData EffectData = Data.InitializationData.IsValid() ?  Data.InitializationData : AbilityEffect->EffectData;
+						ApplyAbilityEffect(AbilityEffect, EffectData);
+						EffectTag = EffectData.EffectTag;
+					}
+					// If the client grace time remaining is below below -1000, it means that it was an outer activation with no client grace time.
+					// In other words, we expect the server to apply the effect without ever telling the client to apply it.
 					if (Wrapper.ClientGraceTimeRemaining <= 0.f && Wrapper.ClientGraceTimeRemaining >= -100.f) {
-						UE_LOG(LogGMCAbilitySystem, Log, TEXT("Client add effect of class %s with tag %s missed grace time, forcing application with id: %d"), *GetNameSafe(Data.EffectClass), *EffectData.EffectTag.ToString(), FX->EffectData.EffectID);
+						UE_LOG(LogGMCAbilitySystem, Log, TEXT("Client add effect of class %s with tag %s missed grace time, forcing application with id: %d"), *GetNameSafe(Data.EffectClass), *EffectTag.ToString(), Wrapper.LateApplicationID);
 					}
 				} break;
 				case EGMC_RemoveEffect: {
@@ -1034,7 +1503,15 @@ void UGMC_AbilitySystemComponent::ClientHandlePendingEffect() {
 					break;
 				}
 
-				UGMCAbilityEffect* AbilityEffect = DuplicateObject(CDO, this);
+				const TSharedPtr<const FGMCLightweightEffectSpec> LightweightSpec = Data.InitializationData.IsValid() ? nullptr : FGMCLightweightEffectSpec::Get(Data.EffectClass);
+				if (LightweightSpec) {
+					FGMCAbilityEffectData EffectData;
+					EffectData.EffectID = LateApplicationData.LateApplicationID;
+					ApplyLightweightEffect(LightweightSpec.ToSharedRef(), EffectData);
+					break;
+				}
+
+				UGMCAbilityEffect* AbilityEffect = AcquireEffect(Data.EffectClass);
 				AbilityEffect->EffectData.EffectID = LateApplicationData.LateApplicationID;
 				FGMCAbilityEffectData EffectData = Data.InitializationData.IsValid() ? Data.InitializationData : AbilityEffect->EffectData;
 				ApplyAbilityEffect(AbilityEffect, EffectData);
@@ -1055,8 +1532,14 @@ void UGMC_AbilitySystemComponent::ClientHandlePendingEffect() {
 
 
 int UGMC_AbilitySystemComponent::GenerateLateApplicationID() {
+	return GenerateEffectID();
+}
+
+
+int UGMC_AbilitySystemComponent::GenerateEffectID() const
+{
 	int NewEffectID = static_cast<int>(ActionTimer * 100);
-	while (ActiveEffects.Contains(NewEffectID))
+	while (IsEffectIDInUse(NewEffectID))
 	{
 		NewEffectID++;
 	}
@@ -1065,6 +1548,25 @@ int UGMC_AbilitySystemComponent::GenerateLateApplicationID() {
 }
 
 
+bool UGMC_AbilitySystemComponent::IsEffectIDInUse(int EffectID) const
+{
+	return ActiveEffects.Contains(EffectID) || LightweightEffectIndices.Contains(EffectID) ||
+		PendingLightweightEffects.ContainsByPredicate([EffectID](const FGMCLightweightEffect& Effect) { return Effect.EffectID == EffectID; });
+}
+
+bool UGMC_AbilitySystemComponent::IsEffectActive(int EffectID) const
+{
+	if (const UGMCAbilityEffect* Effect = ActiveEffects.FindRef(EffectID))
+	{
+		return !Effect->bCompleted;
+	}
+	if (const int32* Index = LightweightEffectIndices.Find(EffectID); Index && LightweightEffects.IsValidIndex(*Index))
+	{
+		return !LightweightEffects[*Index].bCompleted;
+	}
+	return PendingLightweightEffects.ContainsByPredicate([EffectID](const FGMCLightweightEffect& Effect) { return Effect.EffectID == EffectID; });
+}
+
 void UGMC_AbilitySystemComponent::RPCTaskHeartbeat_Implementation(int AbilityID, int TaskID)
 {
 	if (ActiveAbilities.Contains(AbilityID) && ActiveAbilities[AbilityID] != nullptr)
@@ -1080,6 +1582,12 @@ void UGMC_AbilitySystemComponent::RPCClientEndEffect_Implementation(int EffectID
 		ActiveEffects[EffectID]->EndEffect();
 		UE_LOG(LogGMCAbilitySystem, VeryVerbose, TEXT("[RPC] Server Ended Effect: %d"), EffectID);
 	}
+	else if (FGMCLightweightEffect* LightweightEffect = FindLightweightEffect(EffectID))
+	{
+		FLightweightEffectScope Scope(*this);
+		LightweightEffect->EndEffect(*this);
+		UE_LOG(LogGMCAbilitySystem, VeryVerbose, TEXT("[RPC] Server Ended Effect: %d"), EffectID);
+	}
 }
 
 void UGMC_AbilitySystemComponent::RPCClientEndAbility_Implementation(int AbilityID)
@@ -1109,6 +1617,8 @@ void UGMC_AbilitySystemComponent::ApplyStartingEffects(bool bForce) {
 			// Dont apply the same effect twice
 			if (!Algo::FindByPredicate(ActiveEffects, [Effect](const TPair<int, UGMCAbilityEffect*>& ActiveEffect) {
 				return IsValid(ActiveEffect.Value) && ActiveEffect.Value->GetClass() == Effect;
+			}) && !LightweightEffects.ContainsByPredicate([Effect](const FGMCLightweightEffect& LightweightEffect) {
+				return LightweightEffect.Spec->EffectClass == Effect;
 			})) {
 				ApplyAbilityEffect(Effect, FGMCAbilityEffectData{});
 			}
@@ -1237,42 +1747,6 @@ void UGMC_AbilitySystemComponent::InitializeStartingAbilities()
 	}
 }
 
-void UGMC_AbilitySystemComponent::OnRep_UnBoundAttributes()
-{
-	
-	if (OldUnBoundAttributes.Items.Num() != UnBoundAttributes.Items.Num())
-	{
-		UE_LOG(LogGMCAbilitySystem, Error, TEXT("OnRep_UnBoundAttributes: Mismatched Attribute Old != New Value !"));
-	}
-
-	TArray<FAttribute>& OldAttributes = OldUnBoundAttributes.Items;
-	const TArray<FAttribute>& CurrentAttributes = UnBoundAttributes.Items;
-
-	TMap<FGameplayTag, float*> OldValues;
-
-	// If this mitchmatch, that mean we need to reset the number of attributes
-
-	
-	for (FAttribute& Attribute : OldAttributes){
-		OldValues.Add(Attribute.Tag, &Attribute.Value);
-	}
-
-	
-
-	for (const FAttribute& Attribute : CurrentAttributes){
-		if (OldValues.Contains(Attribute.Tag) && *OldValues[Attribute.Tag] != Attribute.Value){
-			NativeAttributeChangeDelegate.Broadcast(Attribute.Tag, *OldValues[Attribute.Tag], Attribute.Value);
-			OnAttributeChanged.Broadcast(Attribute.Tag, *OldValues[Attribute.Tag], Attribute.Value);
-			UnBoundAttributes.MarkAttributeDirty(Attribute);
-
-			// Update Old Value
-			*OldValues[Attribute.Tag] = Attribute.Value;
-		}
-	}
-
-	
-}
-
 //BP Version
 UGMCAbilityEffect* UGMC_AbilitySystemComponent::ApplyAbilityEffect(TSubclassOf<UGMCAbilityEffect> Effect, FGMCAbilityEffectData InitializationData, bool bOuterActivation)
 {
@@ -1291,10 +1765,18 @@ UGMCAbilityEffect* UGMC_AbilitySystemComponent::ApplyAbilityEffect(TSubclassOf<U
 		}
 		return nullptr;
 	}
-	
 
+	// Data-only effects applied with their class defaults don't need an effect object.
+	if (!InitializationData.IsValid())
+	{
+		if (const TSharedPtr<const FGMCLightweightEffectSpec> LightweightSpec = FGMCLightweightEffectSpec::Get(Effect))
+		{
+			ApplyLightweightEffect(LightweightSpec.ToSharedRef(), FGMCAbilityEffectData{});
+			return nullptr;
+		}
+	}
 	
-	UGMCAbilityEffect* AbilityEffect = DuplicateObject(Effect->GetDefaultObject<UGMCAbilityEffect>(), this);
+	UGMCAbilityEffect* AbilityEffect = AcquireEffect(Effect);
 	
 	FGMCAbilityEffectData EffectData;
 	if (InitializationData.IsValid())
@@ -1310,6 +1792,27 @@ UGMCAbilityEffect* UGMC_AbilitySystemComponent::ApplyAbilityEffect(TSubclassOf<U
 	return AbilityEffect;
 }
 
+int UGMC_AbilitySystemComponent::ApplyAbilityEffectByID(TSubclassOf<UGMCAbilityEffect> Effect, FGMCAbilityEffectData InitializationData)
+{
+	if (Effect == nullptr)
+	{
+		UE_LOG(LogGMCAbilitySystem, Error, TEXT("Trying to apply Effect, but effect is null!"));
+		return 0;
+	}
+
+	// Same routing as ApplyAbilityEffect, lightweight effects only having an ID to return.
+	if (!InitializationData.IsValid())
+	{
+		if (const TSharedPtr<const FGMCLightweightEffectSpec> LightweightSpec = FGMCLightweightEffectSpec::Get(Effect))
+		{
+			return ApplyLightweightEffect(LightweightSpec.ToSharedRef(), FGMCAbilityEffectData{});
+		}
+	}
+
+	const UGMCAbilityEffect* AbilityEffect = ApplyAbilityEffect(Effect, InitializationData);
+	return AbilityEffect ? AbilityEffect->EffectData.EffectID : 0;
+}
+
 UGMCAbilityEffect* UGMC_AbilitySystemComponent::ApplyAbilityEffect(UGMCAbilityEffect* Effect, FGMCAbilityEffectData InitializationData)
 {
 	if (Effect == nullptr) {
@@ -1322,6 +1825,8 @@ UGMCAbilityEffect* UGMC_AbilitySystemComponent::ApplyAbilityEffect(UGMCAbilityEf
 	InitializationData.OwnerAbilityComponent = this;
 	Effect->InitializeEffect(InitializationData);
 
+	ValidateEffectModifierChannels(Effect->EffectData);
+
 	if (Effect->EffectData.EffectID == 0)
 	{
 		if (ActionTimer == 0)
@@ -1335,23 +1840,18 @@ UGMCAbilityEffect* UGMC_AbilitySystemComponent::ApplyAbilityEffect(UGMCAbilityEf
 			return nullptr;
 		}
 		
-		int NewEffectID = static_cast<int>(ActionTimer * 100);
-		while (ActiveEffects.Contains(NewEffectID))
-		{
-			NewEffectID++;
-		}
-		Effect->EffectData.EffectID = NewEffectID;
+		Effect->EffectData.EffectID = GenerateEffectID();
 		UE_LOG(LogGMCAbilitySystem, VeryVerbose, TEXT("[Server: %hhd] Generated Effect ID: %d"), HasAuthority(), Effect->EffectData.EffectID);
 	}
 
 	// This is Replicated, so only server needs to manage it
 	if (HasAuthority())
 	{
-		ActiveEffectsData.Push(FActiveEffectsData(Effect->EffectData, Effect->GetClass()));
+		ActiveEffectsData.Add(FActiveEffectsData(Effect->EffectData, Effect->GetClass()));
 	}
 	else
 	{
-		ProcessedEffectIDs.Add(Effect->EffectData.EffectID, false);
+		ProcessedEffectIDs.Add(Effect->EffectData.EffectID, false, ActionTimer);
 	}
 	
 	ActiveEffects.Add(Effect->EffectData.EffectID, Effect);
@@ -1359,6 +1859,11 @@ UGMCAbilityEffect* UGMC_AbilitySystemComponent::ApplyAbilityEffect(UGMCAbilityEf
 	// We run this immediatly, as if the effect is instant, we want to run it right away.
 	Effect->CheckState();
 
+	if (!Effect->bCompleted && !UGMCAbilityEffect::HasPerFrameLogic(Effect->GetClass()))
+	{
+		ScheduleEffect(*Effect);
+	}
+
 	return Effect;
 }
 
@@ -1369,149 +1874,697 @@ void UGMC_AbilitySystemComponent::RemoveActiveAbilityEffect(UGMCAbilityEffect* E
 		return;
 	}
 	
-	if (!ActiveEffects.Contains(Effect->EffectData.EffectID)) return;
+	// Released to the pool and not reused yet. A reused effect can't be told apart from the caller's, hence the ID overload.
+	if (ActiveEffects.FindRef(Effect->EffectData.EffectID) != Effect) return;
 	Effect->EndEffect();
 }
 
-int32 UGMC_AbilitySystemComponent::RemoveEffectByTag(FGameplayTag InEffectTag, int32 NumToRemove, bool bOuterActivation) {
-	
-	if (NumToRemove < -1 || !InEffectTag.IsValid()) {
-		return 0;
-	}
-
-	TMap<int, UGMCAbilityEffect*> EffectsToRemove;
-	int32 NumRemoved = 0;
-	
-	for(const TTuple<int, UGMCAbilityEffect*> Effect : ActiveEffects)
+void UGMC_AbilitySystemComponent::RemoveActiveAbilityEffectByID(int EffectID)
+{
+	if (UGMCAbilityEffect* Effect = ActiveEffects.FindRef(EffectID))
 	{
-		if(NumRemoved == NumToRemove){
-			break;
-		}
-		
-		if(Effect.Value->EffectData.EffectTag.IsValid() && Effect.Value->EffectData.EffectTag.MatchesTagExact(InEffectTag)){
-			EffectsToRemove.Add(Effect.Key, Effect.Value);
-			NumRemoved++;
-		}
-	}
-	
-
-	if (bOuterActivation) {
-		if (HasAuthority() && EffectsToRemove.Num() > 0) {
-
-			TArray<int> EffectIDsToRemove;
-			for (const auto& ToRemove : EffectsToRemove) {
-				EffectIDsToRemove.Add(ToRemove.Key);
-			}
-			
-			FGMCOuterApplicationWrapper Wrapper = FGMCOuterApplicationWrapper::Make<FGMCOuterEffectRemove>(EffectIDsToRemove);
-			AddPendingEffectApplications(Wrapper, 0.3f);
+		if (IsValid(Effect) && !Effect->bCompleted)
+		{
+			Effect->EndEffect();
 		}
-		return 0;
 	}
-
-	for (auto& ToRemove : EffectsToRemove) {
-		ToRemove.Value->EndEffect();
+	else if (FGMCLightweightEffect* LightweightEffect = FindLightweightEffect(EffectID))
+	{
+		LightweightEffect->EndEffect(*this);
 	}
-	
-	return NumRemoved;
 }
 
+int UGMC_AbilitySystemComponent::ApplyLightweightEffect(const TSharedRef<const FGMCLightweightEffectSpec>& Spec, const FGMCAbilityEffectData& InitializationData)
+{
+	FGMCLightweightEffect Effect;
+	Effect.Spec = Spec;
+	Effect.EffectID = InitializationData.EffectID;
+	Effect.ApplicationTime = ActionTimer;
 
-bool UGMC_AbilitySystemComponent::RemoveEffectById(TArray<int> Ids, bool bOuterActivation) {
+	// If server sends times, use those
+	Effect.StartTime = InitializationData.StartTime != 0 ? InitializationData.StartTime : ActionTimer + Spec->Data.Delay;
+	Effect.EndTime = InitializationData.EndTime != 0 ? InitializationData.EndTime : Effect.StartTime + Spec->Data.Duration;
 
-	if (!Ids.Num()) {
-		return true;
-	}
+	ValidateEffectModifierChannels(Spec->Data);
 
-	// check all IDs exists
-	for (int Id : Ids) {
-		if (!ActiveEffects.Contains(Id)) {
-			UE_LOG(LogGMCAbilitySystem, Warning, TEXT("Trying to remove effect with ID %d, but it doesn't exist!"), Id);
-			return false;
+	if (Effect.EffectID == 0)
+	{
+		if (ActionTimer == 0)
+		{
+			UE_LOG(LogGMCAbilitySystem, Error, TEXT("[ApplyLightweightEffect] Action Timer is 0, cannot generate Effect ID. Is it a listen server smoothed pawn?"));
+			return 0;
 		}
-	}
 
-	if (bOuterActivation) {
-		if (HasAuthority()) {
-			FGMCOuterApplicationWrapper Wrapper = FGMCOuterApplicationWrapper::Make<FGMCOuterEffectRemove>(Ids);
-			AddPendingEffectApplications(Wrapper, 0.3f);
+		if (!CanApplyAbilityEffect(Spec->EffectClass->GetDefaultObject<UGMCAbilityEffect>()))
+		{
+			return 0;
 		}
-		return true;
+
+		Effect.EffectID = GenerateEffectID();
+		UE_LOG(LogGMCAbilitySystem, VeryVerbose, TEXT("[Server: %hhd] Generated Effect ID: %d"), HasAuthority(), Effect.EffectID);
 	}
 
-	for (auto& Effect : ActiveEffects) {
-		if (Ids.Contains(Effect.Key)) {
-			Effect.Value->EndEffect();
-		}
+	// This is Replicated, so only server needs to manage it
+	if (HasAuthority())
+	{
+		ActiveEffectsData.Add(FActiveEffectsData(Effect.MakeEffectData(this), Spec->EffectClass, true));
+	}
+	else
+	{
+		ProcessedEffectIDs.Add(Effect.EffectID, false, ActionTimer);
 	}
 
-	return true;
+	const int AppliedEffectID = Effect.EffectID;
+	if (LightweightEffectScopeDepth > 0)
+	{
+		PendingLightweightEffects.Add(MoveTemp(Effect));
+		return AppliedEffectID;
+	}
+
+	// We run this immediatly, as if the effect is instant, we want to run it right away.
+	FLightweightEffectScope Scope(*this);
+	const int32 Index = LightweightEffects.Add(MoveTemp(Effect));
+	LightweightEffectIndices.Add(LightweightEffects[Index].EffectID, Index);
+	ScheduleLightweightEffect(LightweightEffects[Index]);
+	return AppliedEffectID;
 }
 
+void UGMC_AbilitySystemComponent::FlushPendingLightweightEffects()
+{
+	while (!PendingLightweightEffects.IsEmpty())
+	{
+		const int32 FirstAddedEffect = LightweightEffects.Num();
+		LightweightEffects.Append(MoveTemp(PendingLightweightEffects));
+		PendingLightweightEffects.Reset();
 
-int32 UGMC_AbilitySystemComponent::GetNumEffectByTag(FGameplayTag InEffectTag){
-	if(!InEffectTag.IsValid()) return -1;
-	int32 Count = 0;
-	for (const TTuple<int, UGMCAbilityEffect*> Effect : ActiveEffects){
-		if(Effect.Value->EffectData.EffectTag.IsValid() && Effect.Value->EffectData.EffectTag.MatchesTagExact(InEffectTag)){
-			Count++;
+		// Effects applied by these ones go to the pending effects again, and are added by the next iteration.
+		++LightweightEffectScopeDepth;
+		for (int32 Index = FirstAddedEffect; Index < LightweightEffects.Num(); ++Index)
+		{
+			LightweightEffectIndices.Add(LightweightEffects[Index].EffectID, Index);
+			ScheduleLightweightEffect(LightweightEffects[Index]);
 		}
+		--LightweightEffectScopeDepth;
 	}
-	return Count;
 }
 
-FOnAttributeValueChanged* UGMC_AbilitySystemComponent::GetAttributeValueChangedDelegate(FGameplayTag AttributeTag)
+void UGMC_AbilitySystemComponent::ScheduleLightweightEffect(FGMCLightweightEffect& Effect)
 {
-	if (!AttributeTag.IsValid())
+	Effect.TimerSerial = ++LastLightweightEffectTimerSerial;
+
+	// Predicted effects are cancelled if the server doesn't confirm them in time
+	const bool* bServerConfirmed = HasAuthority() ? nullptr : ProcessedEffectIDs.Find(Effect.EffectID);
+	if (bServerConfirmed && !*bServerConfirmed)
 	{
-		return nullptr;
+		LightweightEffectTimers.Schedule(Effect.ApplicationTime + ClientEffectApplicationTimeout, Effect.EffectID, Effect.TimerSerial, EGMCEffectTimerType::ConfirmationTimeout);
 	}
-	return OnAttributeValueChangedDelegateMap.Find(AttributeTag);
-}
 
-void UGMC_AbilitySystemComponent::BroadcastAttributeChangeBySerializedItem(FGameplayTag AttributeTag, float NewValue)
-{
-	FOnAttributeValueChanged* Delegate = GetAttributeValueChangedDelegate(AttributeTag);
-	if (Delegate)
+	// Effects which are already due start right away, instant ones end here.
+	Effect.CheckState(*this);
+
+	if (Effect.bCompleted) return;
+	if (Effect.CurrentState == EGMASEffectState::Initialized)
 	{
-		Delegate->Broadcast(NewValue);
+		LightweightEffectTimers.Schedule(Effect.StartTime, Effect.EffectID, Effect.TimerSerial, EGMCEffectTimerType::Start);
+	}
+	else if (Effect.CurrentState == EGMASEffectState::Started)
+	{
+		ScheduleStartedLightweightEffect(Effect);
 	}
-
-	// We don't have the information over the previous value here, so we send 0 as a default value
-	float PreviousValue = 0.f;
-	OnAttributeChanged.Broadcast(AttributeTag, PreviousValue, NewValue);
-	NativeAttributeChangeDelegate.Broadcast(AttributeTag, PreviousValue, NewValue);
 }
 
-TArray<const FAttribute*> UGMC_AbilitySystemComponent::GetAllAttributes() const{
-	TArray<const FAttribute*> AllAttributes;
-	for (const FAttribute& Attribute : UnBoundAttributes.Items){
-		AllAttributes.Add(&Attribute);
+void UGMC_AbilitySystemComponent::ScheduleStartedLightweightEffect(const FGMCLightweightEffect& Effect)
+{
+	if (Effect.GetData().Duration != 0)
+	{
+		LightweightEffectTimers.Schedule(Effect.EndTime, Effect.EffectID, Effect.TimerSerial, EGMCEffectTimerType::End);
 	}
-
-	for (const FAttribute& Attribute : BoundAttributes.Attributes){
-		AllAttributes.Add(&Attribute);
+	if (Effect.GetData().Period > 0)
+	{
+		LightweightEffectTimers.Schedule(Effect.NextPeriodTime, Effect.EffectID, Effect.TimerSerial, EGMCEffectTimerType::Period);
 	}
-	return AllAttributes;
 }
 
-const FAttribute* UGMC_AbilitySystemComponent::GetAttributeByTag(FGameplayTag AttributeTag) const
+void UGMC_AbilitySystemComponent::TickLightweightEffects()
 {
-	if (AttributeTag == FGameplayTag::EmptyTag) return nullptr;
-	
-	if(!AttributeTag.IsValid()){
-		UE_LOG(LogGMCAbilitySystem, Warning, TEXT("Tried to get an attribute with an invalid tag!"))
+	FLightweightEffectScope Scope(*this);
+
+	// Effects applied from here are pending until the scope ends, their timers only run from the next tick.
+	FGMCEffectTimer Timer;
+	while (LightweightEffectTimers.PopDue(ActionTimer, Timer))
+	{
+		const int32* Index = LightweightEffectIndices.Find(Timer.EffectID);
+		if (!Index) continue;
+
+		FGMCLightweightEffect& Effect = LightweightEffects[*Index];
+		if (Effect.TimerSerial != Timer.Serial || Effect.bCompleted) continue;
+
+		switch (Timer.Type)
+		{
+			case EGMCEffectTimerType::Start:
+				Effect.CheckState(*this);
+				if (!Effect.bCompleted && Effect.CurrentState == EGMASEffectState::Started)
+				{
+					ScheduleStartedLightweightEffect(Effect);
+				}
+				break;
+			case EGMCEffectTimerType::Period:
+				Effect.TickPeriod(*this);
+				// No period is counted past the end time, the end timer applies whatever is left.
+				if (!Effect.bCompleted && Effect.CurrentState == EGMASEffectState::Started &&
+					(Effect.GetData().Duration == 0 || Effect.NextPeriodTime <= Effect.EndTime))
+				{
+					LightweightEffectTimers.Schedule(Effect.NextPeriodTime, Effect.EffectID, Effect.TimerSerial, EGMCEffectTimerType::Period);
+				}
+				break;
+			case EGMCEffectTimerType::End:
+				// Periods due by the end time are applied before ending.
+				Effect.TickPeriod(*this);
+				Effect.CheckState(*this);
+				break;
+			case EGMCEffectTimerType::ConfirmationTimeout:
+				if (const bool* bServerConfirmed = ProcessedEffectIDs.Find(Effect.EffectID); bServerConfirmed && !*bServerConfirmed)
+				{
+					UE_LOG(LogGMCAbilitySystem, Error, TEXT("Effect `%s` Not Confirmed By Server (ID: `%d`), Removing..."), *GetNameSafe(Effect.Spec->EffectClass), Effect.EffectID);
+					Effect.EndEffect(*this);
+				}
+				break;
+		}
+	}
+
+	// Tag requirements can only fail when the active tags change.
+	if (!LightweightEffects.IsEmpty() && ActiveTags != LightweightEffectCheckedTags)
+	{
+		// Effects ending here change the tags again, they're checked once more next tick.
+		LightweightEffectCheckedTags = ActiveTags;
+		for (FGMCLightweightEffect& Effect : LightweightEffects)
+		{
+			if (Effect.HasTagRequirements())
+			{
+				Effect.CheckTagRequirements(*this);
+			}
+		}
+	}
+}
+
+void UGMC_AbilitySystemComponent::RemoveEndedLightweightEffects(TArray<int>& EndedEffectIDs)
+{
+	if (!bEffectsEndedSinceCleanup) return;
+	bEffectsEndedSinceCleanup = false;
+
+	const int32 NumEffects = LightweightEffects.Num();
+	for (const FGMCLightweightEffect& Effect : LightweightEffects)
+	{
+		if (Effect.bCompleted) {EndedEffectIDs.Push(Effect.EffectID);}
+	}
+	LightweightEffects.RemoveAll([](const FGMCLightweightEffect& Effect) { return Effect.bCompleted; });
+	if (LightweightEffects.Num() == NumEffects) return;
+
+	LightweightEffectIndices.Reset();
+	for (int32 Index = 0; Index < LightweightEffects.Num(); ++Index)
+	{
+		LightweightEffectIndices.Add(LightweightEffects[Index].EffectID, Index);
+	}
+
+	// Timers of removed effects are skipped when due, only bother dropping them when they pile up.
+	if (LightweightEffectTimers.Num() > 4 * LightweightEffects.Num() + 16)
+	{
+		LightweightEffectTimers.RemoveAll([this](const FGMCEffectTimer& Timer)
+		{
+			const int32* Index = LightweightEffectIndices.Find(Timer.EffectID);
+			return !Index || LightweightEffects[*Index].TimerSerial != Timer.Serial;
+		});
+	}
+}
+
+void UGMC_AbilitySystemComponent::ScheduleEffect(UGMCAbilityEffect& Effect)
+{
+	Effect.TimerSerial = ++LastEffectTimerSerial;
+
+	// Ticked effects had their tag requirements checked on their first tick, whether the tags changed or not.
+	Effect.CheckTagRequirements();
+	if (Effect.bCompleted) return;
+
+	// Predicted effects are cancelled if the server doesn't confirm them in time
+	const bool* bServerConfirmed = HasAuthority() ? nullptr : ProcessedEffectIDs.Find(Effect.EffectData.EffectID);
+	if (bServerConfirmed && !*bServerConfirmed)
+	{
+		EffectTimers.Schedule(Effect.ClientEffectApplicationTime + ClientEffectApplicationTimeout, Effect.EffectData.EffectID, Effect.TimerSerial, EGMCEffectTimerType::ConfirmationTimeout);
+	}
+
+	if (Effect.CurrentState == EGMASEffectState::Initialized)
+	{
+		EffectTimers.Schedule(Effect.EffectData.StartTime, Effect.EffectData.EffectID, Effect.TimerSerial, EGMCEffectTimerType::Start);
+	}
+	else if (Effect.CurrentState == EGMASEffectState::Started)
+	{
+		ScheduleStartedEffect(Effect);
+	}
+}
+
+void UGMC_AbilitySystemComponent::ScheduleStartedEffect(const UGMCAbilityEffect& Effect)
+{
+	if (Effect.EffectData.Duration != 0)
+	{
+		EffectTimers.Schedule(Effect.EffectData.EndTime, Effect.EffectData.EffectID, Effect.TimerSerial, EGMCEffectTimerType::End);
+	}
+	if (Effect.EffectData.Period > 0)
+	{
+		EffectTimers.Schedule(Effect.GetNextPeriodTime(), Effect.EffectData.EffectID, Effect.TimerSerial, EGMCEffectTimerType::Period);
+	}
+}
+
+void UGMC_AbilitySystemComponent::TickTimedEffects()
+{
+	FGMCEffectTimer Timer;
+	while (EffectTimers.PopDue(ActionTimer, Timer))
+	{
+		UGMCAbilityEffect* Effect = ActiveEffects.FindRef(Timer.EffectID);
+		if (!IsValid(Effect) || Effect->TimerSerial != Timer.Serial || Effect->bCompleted) continue;
+
+		switch (Timer.Type)
+		{
+			case EGMCEffectTimerType::Start:
+				Effect->CheckState();
+				if (!Effect->bCompleted && Effect->CurrentState == EGMASEffectState::Started)
+				{
+					ScheduleStartedEffect(*Effect);
+				}
+				break;
+			case EGMCEffectTimerType::Period:
+				Effect->TickPeriod();
+				// No period is counted past the end time, the end timer applies whatever is left.
+				if (!Effect->bCompleted && Effect->CurrentState == EGMASEffectState::Started &&
+					(Effect->EffectData.Duration == 0 || Effect->GetNextPeriodTime() <= Effect->EffectData.EndTime))
+				{
+					EffectTimers.Schedule(Effect->GetNextPeriodTime(), Timer.EffectID, Timer.Serial, EGMCEffectTimerType::Period);
+				}
+				break;
+			case EGMCEffectTimerType::End:
+				// Periods due by the end time are applied before ending.
+				Effect->TickPeriod();
+				Effect->CheckState();
+				break;
+			case EGMCEffectTimerType::ConfirmationTimeout:
+				if (const bool* bServerConfirmed = ProcessedEffectIDs.Find(Timer.EffectID); bServerConfirmed && !*bServerConfirmed)
+				{
+					UE_LOG(LogGMCAbilitySystem, Error, TEXT("Effect `%s` Not Confirmed By Server (ID: `%d`), Removing..."), *GetNameSafe(Effect), Timer.EffectID);
+					Effect->EndEffect();
+				}
+				break;
+		}
+	}
+
+	// Tag requirements can only fail when the active tags change.
+	if (!ActiveEffects.IsEmpty() && ActiveTags != TimedEffectCheckedTags)
+	{
+		// Effects ending here change the tags again, they're checked once more next tick.
+		TimedEffectCheckedTags = ActiveTags;
+		TArray<UGMCAbilityEffect*, TInlineAllocator<16>> TimedEffects;
+		for (const TPair<int, UGMCAbilityEffect*>& Effect : ActiveEffects)
+		{
+			if (IsValid(Effect.Value) && Effect.Value->TimerSerial != 0)
+			{
+				TimedEffects.Add(Effect.Value);
+			}
+		}
+
+		// Ending effects may apply others, which mustn't change ActiveEffects under the iteration.
+		for (UGMCAbilityEffect* Effect : TimedEffects)
+		{
+			Effect->CheckTagRequirements();
+		}
+	}
+}
+
+FGMCLightweightEffect* UGMC_AbilitySystemComponent::FindLightweightEffect(int EffectID)
+{
+	if (const int32* Index = LightweightEffectIndices.Find(EffectID))
+	{
+		return &LightweightEffects[*Index];
+	}
+	return PendingLightweightEffects.FindByPredicate([EffectID](const FGMCLightweightEffect& Effect) { return Effect.EffectID == EffectID; });
+}
+
+UGMC_AbilitySystemComponent::FLightweightEffectScope::FLightweightEffectScope(UGMC_AbilitySystemComponent& InComponent) : Component(InComponent)
+{
+	++Component.LightweightEffectScopeDepth;
+}
+
+UGMC_AbilitySystemComponent::FLightweightEffectScope::~FLightweightEffectScope()
+{
+	if (--Component.LightweightEffectScopeDepth == 0)
+	{
+		Component.FlushPendingLightweightEffects();
+	}
+}
+
+void UGMC_AbilitySystemComponent::EndStartedEffectsWithTag(const FGameplayTag& EffectTag, int32 ExceptEffectID)
+{
+	const TArray<int32, TInlineAllocator<2>>* StartedEffects = StartedEffectsByTag.Find(EffectTag);
+	if (!StartedEffects) return;
+
+	// Ending an effect removes it from the index.
+	TArray<int32, TInlineAllocator<2>> EffectsToEnd = *StartedEffects;
+	EffectsToEnd.Remove(ExceptEffectID);
+
+	FLightweightEffectScope Scope(*this);
+	for (const int32 EffectID : EffectsToEnd)
+	{
+		if (UGMCAbilityEffect* Effect = ActiveEffects.FindRef(EffectID))
+		{
+			if (IsValid(Effect)) Effect->EndEffect();
+		}
+		else if (FGMCLightweightEffect* LightweightEffect = FindLightweightEffect(EffectID))
+		{
+			LightweightEffect->EndEffect(*this);
+		}
+	}
+}
+
+bool UGMC_AbilitySystemComponent::HasStartedEffectWithStackAttribute(const FGameplayTag& StackAttributeTag, int32 ExceptEffectID) const
+{
+	const TArray<int32, TInlineAllocator<2>>* StartedEffects = StartedEffectsByStackAttribute.Find(StackAttributeTag);
+	return StartedEffects && StartedEffects->ContainsByPredicate([ExceptEffectID](int32 EffectID) { return EffectID != ExceptEffectID; });
+}
+
+void UGMC_AbilitySystemComponent::AddEffectGrantedTags(const FGameplayTagContainer& GrantedTags)
+{
+	for (const FGameplayTag& Tag : GrantedTags)
+	{
+		if (!Tag.IsValid()) continue;
+
+		++EffectGrantedTagCounts.FindOrAdd(Tag);
+		ActiveTags.AddTag(Tag);
+	}
+}
+
+void UGMC_AbilitySystemComponent::RemoveEffectGrantedTags(const FGameplayTagContainer& GrantedTags)
+{
+	for (const FGameplayTag& Tag : GrantedTags)
+	{
+		int32* Count = EffectGrantedTagCounts.Find(Tag);
+		if (Count && --*Count <= 0)
+		{
+			EffectGrantedTagCounts.Remove(Tag);
+			if (!IsActiveTagHeld(Tag))
+			{
+				ActiveTags.RemoveTag(Tag);
+			}
+		}
+	}
+}
+
+void UGMC_AbilitySystemComponent::NotifyEffectStateChanged(int32 EffectID, const FGMCAbilityEffectData& EffectData, EGMASEffectState OldState, EGMASEffectState NewState)
+{
+	if (NewState == EGMASEffectState::Ended)
+	{
+		bEffectsEndedSinceCleanup = true;
+	}
+
+	if (NewState == EGMASEffectState::Started)
+	{
+		StartedEffectsByTag.FindOrAdd(EffectData.EffectTag).Add(EffectID);
+		if (EffectData.EffectStackAttributeTag.IsValid())
+		{
+			StartedEffectsByStackAttribute.FindOrAdd(EffectData.EffectStackAttributeTag).Add(EffectID);
+		}
+	}
+	else if (OldState == EGMASEffectState::Started)
+	{
+		const auto RemoveFromIndex = [EffectID](TMap<FGameplayTag, TArray<int32, TInlineAllocator<2>>>& Index, const FGameplayTag& Key)
+		{
+			TArray<int32, TInlineAllocator<2>>* StartedEffects = Index.Find(Key);
+			if (StartedEffects && StartedEffects->RemoveSingleSwap(EffectID) > 0 && StartedEffects->IsEmpty())
+			{
+				Index.Remove(Key);
+			}
+		};
+
+		RemoveFromIndex(StartedEffectsByTag, EffectData.EffectTag);
+		if (EffectData.EffectStackAttributeTag.IsValid())
+		{
+			RemoveFromIndex(StartedEffectsByStackAttribute, EffectData.EffectStackAttributeTag);
+		}
+	}
+}
+
+UGMCAbilityEffect* UGMC_AbilitySystemComponent::AcquireEffect(TSubclassOf<UGMCAbilityEffect> EffectClass)
+{
+	if (EffectClass == nullptr) return nullptr;
+
+	if (FGMCAbilityEffectPoolBucket* Bucket = EffectPool.Find(EffectClass))
+	{
+		while (!Bucket->Effects.IsEmpty())
+		{
+			UGMCAbilityEffect* PooledEffect = Bucket->Effects.Pop();
+			if (IsValid(PooledEffect))
+			{
+				++EffectPoolStats.Hits;
+				return PooledEffect;
+			}
+		}
+	}
+
+	if (EffectPoolCapacityPerClass > 0)
+	{
+		++EffectPoolStats.Misses;
+	}
+	return DuplicateObject(EffectClass->GetDefaultObject<UGMCAbilityEffect>(), this);
+}
+
+void UGMC_AbilitySystemComponent::ReleaseEffect(UGMCAbilityEffect* Effect)
+{
+	if (EffectPoolCapacityPerClass <= 0 || !IsValid(Effect) || Effect->GetOuter() != this) return;
+
+	FGMCAbilityEffectPoolBucket& Bucket = EffectPool.FindOrAdd(Effect->GetClass());
+	if (Bucket.Effects.Num() >= EffectPoolCapacityPerClass)
+	{
+		++EffectPoolStats.Discarded;
+		return;
+	}
+
+	Effect->ResetForReuse();
+	Bucket.Effects.Add(Effect);
+	++EffectPoolStats.Released;
+}
+
+int32 UGMC_AbilitySystemComponent::RemoveEffectByTag(FGameplayTag InEffectTag, int32 NumToRemove, bool bOuterActivation) {
+	
+	if (NumToRemove < -1 || !InEffectTag.IsValid()) {
+		return 0;
+	}
+
+	TMap<int, UGMCAbilityEffect*> EffectsToRemove;
+	int32 NumRemoved = 0;
+	
+	for(const TTuple<int, UGMCAbilityEffect*> Effect : ActiveEffects)
+	{
+		if(NumRemoved == NumToRemove){
+			break;
+		}
+		
+		if(Effect.Value->EffectData.EffectTag.IsValid() && Effect.Value->EffectData.EffectTag.MatchesTagExact(InEffectTag)){
+			EffectsToRemove.Add(Effect.Key, Effect.Value);
+			NumRemoved++;
+		}
+	}
+
+	TArray<int> LightweightEffectsToRemove;
+	for (const FGMCLightweightEffect& Effect : LightweightEffects)
+	{
+		if(NumRemoved == NumToRemove){
+			break;
+		}
+
+		if(Effect.GetData().EffectTag.IsValid() && Effect.GetData().EffectTag.MatchesTagExact(InEffectTag)){
+			LightweightEffectsToRemove.Add(Effect.EffectID);
+			NumRemoved++;
+		}
+	}
+	
+
+	if (bOuterActivation) {
+		if (HasAuthority() && NumRemoved > 0) {
+
+			TArray<int> EffectIDsToRemove = LightweightEffectsToRemove;
+			for (const auto& ToRemove : EffectsToRemove) {
+				EffectIDsToRemove.Add(ToRemove.Key);
+			}
+			
+			FGMCOuterApplicationWrapper Wrapper = FGMCOuterApplicationWrapper::Make<FGMCOuterEffectRemove>(EffectIDsToRemove);
+			AddPendingEffectApplications(Wrapper, 0.3f);
+		}
+		return 0;
+	}
+
+	for (auto& ToRemove : EffectsToRemove) {
+		ToRemove.Value->EndEffect();
+	}
+
+	FLightweightEffectScope Scope(*this);
+	for (const int EffectID : LightweightEffectsToRemove) {
+		FindLightweightEffect(EffectID)->EndEffect(*this);
+	}
+	
+	return NumRemoved;
+}
+
+
+bool UGMC_AbilitySystemComponent::RemoveEffectById(TArray<int> Ids, bool bOuterActivation) {
+
+	if (!Ids.Num()) {
+		return true;
+	}
+
+	// check all IDs exists
+	for (int Id : Ids) {
+		if (!ActiveEffects.Contains(Id) && !FindLightweightEffect(Id)) {
+			UE_LOG(LogGMCAbilitySystem, Warning, TEXT("Trying to remove effect with ID %d, but it doesn't exist!"), Id);
+			return false;
+		}
+	}
+
+	if (bOuterActivation) {
+		if (HasAuthority()) {
+			FGMCOuterApplicationWrapper Wrapper = FGMCOuterApplicationWrapper::Make<FGMCOuterEffectRemove>(Ids);
+			AddPendingEffectApplications(Wrapper, 0.3f);
+		}
+		return true;
+	}
+
+	for (auto& Effect : ActiveEffects) {
+		if (Ids.Contains(Effect.Key)) {
+			Effect.Value->EndEffect();
+		}
+	}
+
+	FLightweightEffectScope Scope(*this);
+	for (int Id : Ids) {
+		if (FGMCLightweightEffect* LightweightEffect = FindLightweightEffect(Id)) {
+			LightweightEffect->EndEffect(*this);
+		}
+	}
+
+	return true;
+}
+
+
+int32 UGMC_AbilitySystemComponent::GetNumEffectByTag(FGameplayTag InEffectTag){
+	if(!InEffectTag.IsValid()) return -1;
+	int32 Count = 0;
+	for (const TTuple<int, UGMCAbilityEffect*> Effect : ActiveEffects){
+		if(Effect.Value->EffectData.EffectTag.IsValid() && Effect.Value->EffectData.EffectTag.MatchesTagExact(InEffectTag)){
+			Count++;
+		}
+	}
+	for (const FGMCLightweightEffect& Effect : LightweightEffects){
+		if(Effect.GetData().EffectTag.IsValid() && Effect.GetData().EffectTag.MatchesTagExact(InEffectTag)){
+			Count++;
+		}
+	}
+	return Count;
+}
+
+FOnAttributeValueChanged* UGMC_AbilitySystemComponent::GetAttributeValueChangedDelegate(FGameplayTag AttributeTag)
+{
+	if (!AttributeTag.IsValid())
+	{
+		return nullptr;
+	}
+	return OnAttributeValueChangedDelegateMap.Find(AttributeTag);
+}
+
+void UGMC_AbilitySystemComponent::BroadcastAttributeChangeBySerializedItem(FGameplayTag AttributeTag, float OldValue, float NewValue)
+{
+	FOnAttributeValueChanged* Delegate = GetAttributeValueChangedDelegate(AttributeTag);
+	if (Delegate)
+	{
+		Delegate->Broadcast(NewValue);
+	}
+
+	OnAttributeChanged.Broadcast(AttributeTag, OldValue, NewValue);
+	NativeAttributeChangeDelegate.Broadcast(AttributeTag, OldValue, NewValue);
+}
+
+TArray<const FAttribute*> UGMC_AbilitySystemComponent::GetAllAttributes() const{
+	TArray<const FAttribute*> AllAttributes;
+	for (const FAttribute& Attribute : UnBoundAttributes.Items){
+		AllAttributes.Add(&Attribute);
+	}
+
+	for (const FAttribute& Attribute : BoundAttributes.Attributes){
+		AllAttributes.Add(&Attribute);
+	}
+	return AllAttributes;
+}
+
+const FAttribute* UGMC_AbilitySystemComponent::GetAttributeByTag(FGameplayTag AttributeTag) const
+{
+	if (AttributeTag == FGameplayTag::EmptyTag) return nullptr;
+	
+	if(!AttributeTag.IsValid()){
+		UE_LOG(LogGMCAbilitySystem, Warning, TEXT("Tried to get an attribute with an invalid tag!"))
 		return nullptr;
 	}
-	TArray<const FAttribute*> AllAttributes = GetAllAttributes();
-	const FAttribute** FoundAttribute = AllAttributes.FindByPredicate([AttributeTag](const FAttribute* Attribute){
-		return Attribute->Tag.MatchesTagExact(AttributeTag);
-	});
-	
-	if(FoundAttribute && *FoundAttribute){
-		return *FoundAttribute;
+
+	return GetAttributeByHandle(GetAttributeHandle(AttributeTag));
+}
+
+FGMCAttributeHandle UGMC_AbilitySystemComponent::GetAttributeHandle(FGameplayTag AttributeTag) const
+{
+	if (!AttributeTag.IsValid() || !AttributeLayout) return FGMCAttributeHandle();
+
+	const int32 Slot = AttributeLayout->FindSlot(AttributeTag);
+	if (Slot == INDEX_NONE) return FGMCAttributeHandle();
+
+	return FGMCAttributeHandle(AttributeTag, Slot < AttributeLayout->GetNumBound(), Slot, AttributeLayoutSerial);
+}
+
+const FAttribute* UGMC_AbilitySystemComponent::GetAttributeByHandle(const FGMCAttributeHandle& Handle) const
+{
+	if (!Handle.IsValid()) return nullptr;
+
+	// The layout changed since this handle was resolved, fall back on its tag.
+	if (Handle.LayoutSerial != AttributeLayoutSerial)
+	{
+		const FGMCAttributeHandle Resolved = GetAttributeHandle(Handle.Tag);
+		return Resolved.IsValid() ? GetAttributeByNode(Resolved.Index) : nullptr;
 	}
-	return nullptr;
+
+	return GetAttributeByNode(Handle.Index);
+}
+
+float UGMC_AbilitySystemComponent::GetAttributeValueByHandle(const FGMCAttributeHandle& Handle) const
+{
+	if (const FAttribute* Att = GetAttributeByHandle(Handle))
+	{
+		return Att->Value;
+	}
+	return 0;
+}
+
+float UGMC_AbilitySystemComponent::GetAttributeValueAtTime(const FGMCAttributeHandle& Handle, double Time) const
+{
+	// A stale handle is resolved again, as the history is recorded against the current layout.
+	const int32 Slot = Handle.LayoutSerial == AttributeLayoutSerial ? GetAttributeNode(Handle) : GetAttributeHandle(Handle.Tag).Index;
+
+	float Value;
+	if (Slot != INDEX_NONE && AttributeHistory.SampleValue(Slot, Time, Value))
+	{
+		return Value;
+	}
+	return GetAttributeValueByHandle(Handle);
+}
+
+bool UGMC_AbilitySystemComponent::HadActiveTagAtTime(FGameplayTag GameplayTag, double Time) const
+{
+	bool bActive;
+	if (AttributeHistory.SampleTag(GameplayTag, Time, false, bActive))
+	{
+		return bActive;
+	}
+	return HasActiveTag(GameplayTag);
 }
 
 float UGMC_AbilitySystemComponent::GetAttributeValueByTag(const FGameplayTag AttributeTag) const
@@ -1535,16 +2588,28 @@ FAttributeClamp UGMC_AbilitySystemComponent::GetAttributeClampByTag(FGameplayTag
 
 bool UGMC_AbilitySystemComponent::SetAttributeValueByTag(FGameplayTag AttributeTag, float NewValue, bool bResetModifiers)
 {
-	if (const FAttribute* Att = GetAttributeByTag(AttributeTag))
+	const FGMCAttributeHandle Handle = GetAttributeHandle(AttributeTag);
+	if (const FAttribute* Att = GetAttributeByHandle(Handle))
 	{
 		Att->SetBaseValue(NewValue);
 
 		if (bResetModifiers)
 		{
 			Att->ResetModifiers();
+
+			// Effects still running won't take anything out of these channels when they end.
+			for (const EModifierType ModifierType : {EModifierType::Multiply, EModifierType::Divide})
+			{
+				ModifierAggregator.ResetChannel(GetAttributeNode(Handle), ModifierType);
+				if (float* UnownedModifier = FindRolledBackUnownedModifier(GetAttributeNode(Handle), ModifierType))
+				{
+					*UnownedModifier = 0.f;
+				}
+			}
 		}
 
 		Att->CalculateValue();
+		MarkAttributeDirty(GetAttributeNode(Handle));
 		return true;
 	}
 	return false;
@@ -1552,8 +2617,17 @@ bool UGMC_AbilitySystemComponent::SetAttributeValueByTag(FGameplayTag AttributeT
 
 float UGMC_AbilitySystemComponent::GetBaseAttributeValueByTag(FGameplayTag AttributeTag) const{
 	if(!AttributeTag.IsValid()){return -1.0f;}
-	for(UGMCAttributesData* DataAsset : AttributeDataAssets){
-		for(FAttributeData DefaultAttribute : DataAsset->AttributeData){
+
+	if (AttributeLayout)
+	{
+		const int32 Slot = AttributeLayout->FindSlot(AttributeTag);
+		return Slot != INDEX_NONE ? AttributeLayout->GetDefaultValue(Slot) : -1.0f;
+	}
+
+	// Attributes haven't been instantiated yet, read the data assets directly.
+	for(const UGMCAttributesData* DataAsset : AttributeDataAssets){
+		if (!DataAsset) continue;
+		for(const FAttributeData& DefaultAttribute : DataAsset->AttributeData){
 			if(DefaultAttribute.AttributeTag.IsValid() && AttributeTag.MatchesTagExact(DefaultAttribute.AttributeTag)){
 				return DefaultAttribute.DefaultValue;
 			}
@@ -1562,6 +2636,29 @@ float UGMC_AbilitySystemComponent::GetBaseAttributeValueByTag(FGameplayTag Attri
 	return -1.0f;
 }
 
+float UGMC_AbilitySystemComponent::GetBaseAttributeValueByHandle(const FGMCAttributeHandle& Handle) const
+{
+	if (!Handle.IsValid()) return -1.0f;
+
+	// The layout changed since this handle was resolved, fall back on its tag.
+	if (Handle.LayoutSerial != AttributeLayoutSerial || !AttributeLayout || Handle.Index >= AttributeLayout->Num())
+	{
+		return GetBaseAttributeValueByTag(Handle.Tag);
+	}
+
+	return AttributeLayout->GetDefaultValue(Handle.Index);
+}
+
+void UGMC_AbilitySystemComponent::GetBaseAttributeValues(TConstArrayView<FGMCAttributeHandle> Handles, TArrayView<float> OutValues) const
+{
+	check(OutValues.Num() >= Handles.Num());
+
+	for (int32 Index = 0; Index < Handles.Num(); ++Index)
+	{
+		OutValues[Index] = GetBaseAttributeValueByHandle(Handles[Index]);
+	}
+}
+
 #pragma region ToStringHelpers
 
 FString UGMC_AbilitySystemComponent::GetAllAttributesString() const{
@@ -1574,7 +2671,7 @@ FString UGMC_AbilitySystemComponent::GetAllAttributesString() const{
 
 FString UGMC_AbilitySystemComponent::GetActiveEffectsDataString() const{
 	FString FinalString = TEXT("\n");
-	for(const FActiveEffectsData& ActiveEffectData : ActiveEffectsData){
+	for(const FActiveEffectsData& ActiveEffectData : ActiveEffectsData.Items){
 		FinalString += ActiveEffectData.Data.ToString() + TEXT("\n");
 	}
 	return FinalString;
@@ -1585,6 +2682,9 @@ FString UGMC_AbilitySystemComponent::GetActiveEffectsString() const{
 	for(const TTuple<int, UGMCAbilityEffect*> ActiveEffect : ActiveEffects){
 		FinalString += ActiveEffect.Value->ToString() + TEXT("\n");
 	}
+	for(const FGMCLightweightEffect& LightweightEffect : LightweightEffects){
+		FinalString += LightweightEffect.ToString(ActionTimer) + TEXT("\n");
+	}
 	return FinalString;
 }
 
@@ -1600,66 +2700,422 @@ FString UGMC_AbilitySystemComponent::GetActiveAbilitiesString() const{
 
 void UGMC_AbilitySystemComponent::ApplyAbilityEffectModifier(FGMCAttributeModifier AttributeModifier, bool bModifyBaseValue, bool bNegateValue,  UGMC_AbilitySystemComponent* SourceAbilityComponent)
 {
-	// Provide an opportunity to modify the attribute modifier before applying it
-	UGMCAttributeModifierContainer* AttributeModifierContainer = NewObject<UGMCAttributeModifierContainer>(this);
-	AttributeModifierContainer->AttributeModifier = AttributeModifier;
+	ApplyAbilityEffectModifiers(MakeArrayView(&AttributeModifier, 1), bModifyBaseValue, bNegateValue, SourceAbilityComponent);
+}
 
-	// Broadcast the event to allow modifications to happen before application
-	OnPreAttributeChanged.Broadcast(AttributeModifierContainer, SourceAbilityComponent);
+void UGMC_AbilitySystemComponent::ApplyAbilityEffectModifiers(TConstArrayView<FGMCAttributeModifier> AttributeModifiers, bool bModifyBaseValue, bool bNegateValue, UGMC_AbilitySystemComponent* SourceAbilityComponent, int32 NumApplications)
+{
+	// Clamps between modifiers make scaled values differ from repeated batches (e.g. +50 then -30 on a value close to its
+	// max), so several modifiers are applied batch after batch.
+	if (NumApplications > 1 && AttributeModifiers.Num() > 1)
+	{
+		for (int32 Application = 0; Application < NumApplications; ++Application)
+		{
+			ApplyAbilityEffectModifiers(AttributeModifiers, bModifyBaseValue, bNegateValue, SourceAbilityComponent);
+		}
+		return;
+	}
 
-	// Apply the modified attribute modifier. If no changes were made, it's just the same as the original
-	// Extra copying going on here? Can this be done with a reference? BPs are weird.
-	AttributeModifier = AttributeModifierContainer->AttributeModifier;
-	
-	if (const FAttribute* AffectedAttribute = GetAttributeByTag(AttributeModifier.AttributeTag))
+	FAttributeChangeBatch Batch;
+
+	for (FGMCAttributeModifier AttributeModifier : AttributeModifiers)
 	{
+		// Provide an opportunity to modify the attribute modifier before applying it
+		BroadcastPreAttributeChange(AttributeModifier, SourceAbilityComponent);
+
+		const FGMCAttributeHandle Handle = GetAttributeHandle(AttributeModifier.AttributeTag);
+		const FAttribute* AffectedAttribute = GetAttributeByHandle(Handle);
+		if (!AffectedAttribute) continue;
+
 		// If we are unbound that means we shouldn't predict.
-		if(!AffectedAttribute->bIsGMCBound && !HasAuthority()) return;
-		float OldValue = AffectedAttribute->Value;
-		FGMCUnboundAttributeSet OldUnboundAttributes = UnBoundAttributes;
-		
+		if(!AffectedAttribute->bIsGMCBound && !HasAuthority()) continue;
+
+		// Keep the value from before the batch, so that a single change is reported per attribute.
+		const int32 Node = GetAttributeNode(Handle);
+		AddPendingAttributeChange(Batch, Node, AffectedAttribute->Value);
+
+		// A single modifier is clamped the same way whether it's applied N times or scaled by N.
+		AttributeModifier.Value *= NumApplications;
+
 		if (bNegateValue)
 		{
 			AttributeModifier.Value = -AttributeModifier.Value;
 		}
-		AffectedAttribute->ApplyModifier(AttributeModifier, bModifyBaseValue);
 
-		// Only broadcast a change if we've genuinely changed.
-		if (OldValue != AffectedAttribute->Value)
+		// Only additive modifiers can go into the base value, the others always target their modifier channel.
+		if (bModifyBaseValue && AttributeModifier.ModifierType == EModifierType::Add)
+		{
+			AffectedAttribute->ApplyModifier(AttributeModifier, true);
+		}
+		else
 		{
-			OnAttributeChanged.Broadcast(AffectedAttribute->Tag, OldValue, AffectedAttribute->Value);
-			NativeAttributeChangeDelegate.Broadcast(AffectedAttribute->Tag, OldValue, AffectedAttribute->Value);
-			if (FOnAttributeValueChanged* Delegate = OnAttributeValueChangedDelegateMap.Find(AffectedAttribute->Tag))
+			// This modifier doesn't belong to any effect. On channels rolled back by the GMC, it must be rolled back too.
+			if (float* UnownedModifier = FindRolledBackUnownedModifier(Node, AttributeModifier.ModifierType))
+			{
+				*UnownedModifier += AttributeModifier.Value;
+			}
+			else
 			{
-				Delegate->Broadcast(AffectedAttribute->Value);
+				ModifierAggregator.AddUnowned(Node, AttributeModifier.ModifierType, AttributeModifier.Value);
 			}
+			SyncModifierChannel(*AffectedAttribute, Node, AttributeModifier.ModifierType);
 		}
-		
-		BoundAttributes.MarkAttributeDirty(*AffectedAttribute);
-		UnBoundAttributes.MarkAttributeDirty(*AffectedAttribute);
-		if (!AffectedAttribute->bIsGMCBound) {
-			OnRep_UnBoundAttributes();
+	}
+
+	if (Batch.IsEmpty()) return;
+
+	// Finally, update every attribute clamped by the ones we modified, if needed.
+	ResolveAttributeClamps(Batch);
+	CommitAttributeChanges(Batch);
+}
+
+void UGMC_AbilitySystemComponent::AddEffectModifiers(int32 EffectID, TConstArrayView<FGMCAttributeModifier> AttributeModifiers, UGMC_AbilitySystemComponent* SourceAbilityComponent)
+{
+	FAttributeChangeBatch Batch;
+
+	for (FGMCAttributeModifier AttributeModifier : AttributeModifiers)
+	{
+		// The modifier is stored as altered by the listeners, so that removing it takes out exactly what was added.
+		BroadcastPreAttributeChange(AttributeModifier, SourceAbilityComponent);
+
+		const FGMCAttributeHandle Handle = GetAttributeHandle(AttributeModifier.AttributeTag);
+		const FAttribute* AffectedAttribute = GetAttributeByHandle(Handle);
+		if (!AffectedAttribute) continue;
+
+		// If we are unbound that means we shouldn't predict.
+		if(!AffectedAttribute->bIsGMCBound && !HasAuthority()) continue;
+
+		const int32 Node = GetAttributeNode(Handle);
+		AddPendingAttributeChange(Batch, Node, AffectedAttribute->Value);
+
+		ModifierAggregator.Add(EffectID, Node, AttributeModifier.ModifierType, AttributeModifier.Value);
+		SyncModifierChannel(*AffectedAttribute, Node, AttributeModifier.ModifierType);
+	}
+
+	if (Batch.IsEmpty()) return;
+
+	ResolveAttributeClamps(Batch);
+	CommitAttributeChanges(Batch);
+}
+
+void UGMC_AbilitySystemComponent::RemoveEffectModifiers(int32 EffectID)
+{
+	FGMCAttributeModifierAggregator::FEffectModifiers Modifiers;
+	ModifierAggregator.Remove(EffectID, Modifiers);
+
+	FAttributeChangeBatch Batch;
+	for (const FGMCAttributeModifierAggregator::FEffectModifier& Modifier : Modifiers)
+	{
+		const FAttribute* AffectedAttribute = GetAttributeByNode(Modifier.Slot);
+		if (!AffectedAttribute) continue;
+
+		AddPendingAttributeChange(Batch, Modifier.Slot, AffectedAttribute->Value);
+		SyncModifierChannel(*AffectedAttribute, Modifier.Slot, Modifier.ModifierType);
+	}
+
+	if (Batch.IsEmpty()) return;
+
+	ResolveAttributeClamps(Batch);
+	CommitAttributeChanges(Batch);
+}
+
+TArray<FGMCAttributeModifierContribution> UGMC_AbilitySystemComponent::GetAttributeModifierBreakdown(const FGMCAttributeHandle& Handle) const
+{
+	TArray<FGMCAttributeModifierContribution> Contributions;
+
+	const int32 Slot = Handle.LayoutSerial == AttributeLayoutSerial ? GetAttributeNode(Handle) : GetAttributeHandle(Handle.Tag).Index;
+
+	// Modifiers without an effect on channels rolled back by the GMC aren't summed by the aggregator.
+	for (const EModifierType ModifierType : {EModifierType::Add, EModifierType::Multiply, EModifierType::Divide})
+	{
+		const float* UnownedModifier = FindRolledBackUnownedModifier(Slot, ModifierType);
+		if (UnownedModifier && *UnownedModifier != 0.f)
+		{
+			Contributions.Add({INDEX_NONE, ModifierType, *UnownedModifier});
 		}
+	}
+
+	ModifierAggregator.GetContributions(Slot, Contributions);
+	return Contributions;
+}
+
+void UGMC_AbilitySystemComponent::AddPendingAttributeChange(FAttributeChangeBatch& Batch, int32 Node, float OldValue)
+{
+	if (!Batch.ContainsByPredicate([Node](const FPendingAttributeChange& Change) { return Change.Node == Node; }))
+	{
+		Batch.Add({Node, OldValue});
+	}
+}
+
+void UGMC_AbilitySystemComponent::SyncModifierChannel(const FAttribute& Attribute, int32 Node, EModifierType ModifierType)
+{
+	if (const float* UnownedModifier = FindRolledBackUnownedModifier(Node, ModifierType))
+	{
+		Attribute.SetModifier(ModifierType, ModifierAggregator.GetChannelValue(Node, ModifierType, *UnownedModifier));
+	}
+	else
+	{
+		Attribute.SetModifier(ModifierType, ModifierAggregator.GetChannelValue(Node, ModifierType));
+	}
+	Attribute.CalculateValue();
+}
+
+bool UGMC_AbilitySystemComponent::IsModifierChannelRolledBack(int32 Node, EModifierType ModifierType) const
+{
+	if (!AttributeLayout || Node < 0 || Node >= AttributeLayout->GetNumBound()) return false;
+
+	return AttributeLayout->GetEntry(Node).IsModifierChannelBound(GetModifierChannel(ModifierType));
+}
+
+float* UGMC_AbilitySystemComponent::FindRolledBackUnownedModifier(int32 Node, EModifierType ModifierType)
+{
+	if (!IsModifierChannelRolledBack(Node, ModifierType)) return nullptr;
+
+	const int32 Index = Node * FGMCAttributeModifierAggregator::NumChannels + FGMCAttributeModifierAggregator::GetChannelIndex(ModifierType);
+	return RolledBackUnownedModifiers.IsValidIndex(Index) ? &RolledBackUnownedModifiers[Index] : nullptr;
+}
+
+const float* UGMC_AbilitySystemComponent::FindRolledBackUnownedModifier(int32 Node, EModifierType ModifierType) const
+{
+	return const_cast<UGMC_AbilitySystemComponent*>(this)->FindRolledBackUnownedModifier(Node, ModifierType);
+}
+
+void UGMC_AbilitySystemComponent::ResolveAttributeClamps(FAttributeChangeBatch& Batch)
+{
+	if (!AttributeLayout) return;
+	const FGMCAttributeClampGraph& AttributeClampGraph = AttributeLayout->GetClampGraph();
 
-		// Finally, check all AttributesClampedBySelf, and update them if needed.
-		for (const FGameplayTag& AttributeClampedBySelf : AffectedAttribute->AttributesClampedBySelf)
+	// Every attribute clamped, directly or not, by a modified one.
+	TArray<int32, TInlineAllocator<16>> Dependents;
+	for (const FPendingAttributeChange& Change : Batch)
+	{
+		if (Change.Node >= AttributeClampGraph.Num()) continue;
+		for (const int32 Dependent : AttributeClampGraph.GetDependents(Change.Node))
 		{
-			const FAttribute* ClampedAttribute = GetAttributeByTag(AttributeClampedBySelf);
+			Dependents.AddUnique(Dependent);
+		}
+	}
+	if (Dependents.IsEmpty()) return;
 
-			// If the value has changed and we are performing a max clamp, we need to broadcast a change.
-			if (ClampedAttribute && OldValue != AffectedAttribute->Value && ClampedAttribute->Clamp.MaxAttributeTag == AttributeModifier.AttributeTag)
-			{
-				OnAttributeMaxClampChanged(ClampedAttribute->Tag, AttributeModifier.AttributeTag, OldValue, AffectedAttribute->Value);
-			}
+	// An attribute must always be visited after the ones clamping it.
+	if (Batch.Num() > 1)
+	{
+		Dependents.Sort([&AttributeClampGraph](int32 A, int32 B) { return AttributeClampGraph.GetRank(A) < AttributeClampGraph.GetRank(B); });
+	}
+
+	for (const int32 Node : Dependents)
+	{
+		const FAttribute* ClampedAttribute = GetAttributeByNode(Node);
+		if (!ClampedAttribute) continue;
 
-			// We know that we need to update the value if the clamp is different from its current value.
-			if (ClampedAttribute && ClampedAttribute->Value != ClampedAttribute->Clamp.ClampValue(ClampedAttribute->Value))
+		// If the value has changed and we are performing a max clamp, we need to broadcast a change.
+		const int32 MaxSource = AttributeClampGraph.GetMaxSource(Node);
+		if (const FPendingAttributeChange* MaxChange = Batch.FindByPredicate([MaxSource](const FPendingAttributeChange& Change) { return Change.Node == MaxSource; }))
+		{
+			const FAttribute* MaxAttribute = GetAttributeByNode(MaxSource);
+			if (MaxAttribute && MaxAttribute->Value != MaxChange->OldValue)
 			{
-				FGMCAttributeModifier ClampedAttributeModifier;
-				ClampedAttributeModifier.AttributeTag = AttributeClampedBySelf;
-				ApplyAbilityEffectModifier(ClampedAttributeModifier, true, false, this);
+				OnAttributeMaxClampChanged(ClampedAttribute->Tag, MaxAttribute->Tag, MaxChange->OldValue, MaxAttribute->Value);
 			}
 		}
+
+		// If we are unbound that means we shouldn't predict.
+		if (!ClampedAttribute->bIsGMCBound && !HasAuthority()) continue;
+
+		// We know that we need to update the value if the clamp is different from its current value.
+		if (ClampedAttribute->Value == ClampedAttribute->Clamp.ClampValue(ClampedAttribute->Value)) continue;
+
+		AddPendingAttributeChange(Batch, Node, ClampedAttribute->Value);
+
+		ClampedAttribute->SetBaseValue(ClampedAttribute->BaseValueRef());
+		ClampedAttribute->CalculateValue();
+	}
+}
+
+void UGMC_AbilitySystemComponent::CommitAttributeChanges(const FAttributeChangeBatch& Batch)
+{
+	for (const FPendingAttributeChange& Change : Batch)
+	{
+		const FAttribute* Attribute = GetAttributeByNode(Change.Node);
+
+		// Only broadcast a change if we've genuinely changed.
+		if (Attribute && Attribute->Value != Change.OldValue)
+		{
+			BroadcastAttributeChange(*Attribute, Change.OldValue);
+		}
+
+		MarkAttributeDirty(Change.Node);
+	}
+}
+
+void UGMC_AbilitySystemComponent::ValidateEffectModifierChannels(const FGMCAbilityEffectData& EffectData)
+{
+	auto Validate = [this, &EffectData](const FGameplayTag& AttributeTag, EGMCAttributeModifierChannel Channel)
+	{
+		const int32 Slot = AttributeLayout ? AttributeLayout->FindSlot(AttributeTag) : INDEX_NONE;
+		if (Slot == INDEX_NONE || AttributeLayout->GetEntry(Slot).IsModifierChannelBound(Channel)) return;
+
+		bool bAlreadyReported = false;
+		ReportedUnboundModifierChannels.Add({AttributeTag, Channel}, &bAlreadyReported);
+		if (!bAlreadyReported)
+		{
+			UE_LOG(LogGMCAbilitySystem, Warning, TEXT("Effect %s modifies the %s channel of %s, which isn't bound to the GMC. It will not be predicted correctly, add the channel to the attribute data."),
+				*EffectData.EffectTag.ToString(), *UEnum::GetValueAsString(Channel), *AttributeTag.ToString());
+		}
+	};
+
+	// Instant and periodic effects put their additive modifiers into the base value, every other modifier goes into its
+	// modifier channel whatever the kind of effect.
+	const bool bModifiesBaseValue = EffectData.bIsInstant || EffectData.Period != 0;
+	for (const FGMCAttributeModifier& Modifier : EffectData.Modifiers)
+	{
+		if (bModifiesBaseValue && Modifier.ModifierType == EModifierType::Add) continue;
+
+		Validate(Modifier.AttributeTag, GetModifierChannel(Modifier.ModifierType));
+	}
+
+	// Stacks are counted through the additive modifier.
+	if (EffectData.EffectStackAttributeTag.IsValid())
+	{
+		Validate(EffectData.EffectStackAttributeTag, EGMCAttributeModifierChannel::Additive);
+	}
+}
+
+void UGMC_AbilitySystemComponent::EncodeQuantizedAttributes()
+{
+	if (QuantizedAttributeWords.IsEmpty()) return;
+
+	FMemory::Memzero(QuantizedAttributeWords.GetData(), QuantizedAttributeWords.Num() * sizeof(int32));
+
+	for (const FGMCQuantizedAttributeChannel& Entry : AttributeLayout->GetQuantizedChannels())
+	{
+		const FAttribute& Attribute = BoundAttributes.Attributes[Entry.Slot];
+		const FGMCAttributeQuantization& Quantization = AttributeLayout->GetEntry(Entry.Slot).Quantization;
+		const float Value = Attribute.ChannelRef(Entry.Channel);
+
+		// Additive modifiers are offsets, they aren't relative to the origin.
+		const float Origin = Entry.Channel == EGMCAttributeChannel::AdditiveModifier ? 0.f : Quantization.FixedPointOrigin;
+
+		uint32 Bits = 0;
+		switch (Entry.Codec)
+		{
+		case EGMCAttributePrecision::Half:
+			Bits = FGMCAttributeQuantization::EncodeHalf(Value);
+			break;
+		case EGMCAttributePrecision::FixedPoint:
+			Bits = FGMCAttributeQuantization::EncodeFixedPoint(Value, Origin, Quantization.FixedPointStep);
+			break;
+		case EGMCAttributePrecision::Integer:
+			Bits = static_cast<uint32>(FGMCAttributeQuantization::EncodeInteger(Value));
+			break;
+		default:
+			break;
+		}
+
+		int32& Word = QuantizedAttributeWords[Entry.Word];
+		Word = static_cast<int32>(static_cast<uint32>(Word) | (Bits << Entry.Shift));
+	}
+}
+
+void UGMC_AbilitySystemComponent::DecodeQuantizedAttributes()
+{
+	if (QuantizedAttributeWords.IsEmpty()) return;
+
+	for (const FGMCQuantizedAttributeChannel& Entry : AttributeLayout->GetQuantizedChannels())
+	{
+		const FAttribute& Attribute = BoundAttributes.Attributes[Entry.Slot];
+		const FGMCAttributeQuantization& Quantization = AttributeLayout->GetEntry(Entry.Slot).Quantization;
+		const uint32 Word = static_cast<uint32>(QuantizedAttributeWords[Entry.Word]);
+		const uint16 HalfWord = static_cast<uint16>(Word >> Entry.Shift);
+		const float Origin = Entry.Channel == EGMCAttributeChannel::AdditiveModifier ? 0.f : Quantization.FixedPointOrigin;
+
+		float& Value = Attribute.ChannelRef(Entry.Channel);
+		switch (Entry.Codec)
+		{
+		case EGMCAttributePrecision::Half:
+			Value = FGMCAttributeQuantization::DecodeHalf(HalfWord);
+			break;
+		case EGMCAttributePrecision::FixedPoint:
+			Value = FGMCAttributeQuantization::DecodeFixedPoint(HalfWord, Origin, Quantization.FixedPointStep);
+			break;
+		case EGMCAttributePrecision::Integer:
+			Value = static_cast<float>(static_cast<int32>(Word));
+			break;
+		default:
+			break;
+		}
+	}
+
+	for (const FAttribute& Attribute : BoundAttributes.Attributes)
+	{
+		Attribute.SyncFromColumns();
+	}
+}
+
+void UGMC_AbilitySystemComponent::BroadcastPreAttributeChange(FGMCAttributeModifier& AttributeModifier, UGMC_AbilitySystemComponent* SourceAbilityComponent)
+{
+	NativePreAttributeChangeDelegate.Broadcast(AttributeModifier, SourceAbilityComponent);
+
+	if (!OnPreAttributeChanged.IsBound()) return;
+
+	// Blueprints need an object to modify, reuse ours unless a listener is applying a modifier from within the event.
+	UGMCAttributeModifierContainer* AttributeModifierContainer = PreAttributeChangeContainer;
+	if (bPreAttributeChangeContainerInUse || !AttributeModifierContainer)
+	{
+		AttributeModifierContainer = NewObject<UGMCAttributeModifierContainer>(this);
+		if (!bPreAttributeChangeContainerInUse)
+		{
+			PreAttributeChangeContainer = AttributeModifierContainer;
+		}
+	}
+
+	const bool bUsePooledContainer = AttributeModifierContainer == PreAttributeChangeContainer;
+	if (bUsePooledContainer)
+	{
+		bPreAttributeChangeContainerInUse = true;
+	}
+
+	AttributeModifierContainer->AttributeModifier = AttributeModifier;
+	OnPreAttributeChanged.Broadcast(AttributeModifierContainer, SourceAbilityComponent);
+
+	// If no changes were made, it's just the same as the original
+	AttributeModifier = AttributeModifierContainer->AttributeModifier;
+
+	if (bUsePooledContainer)
+	{
+		bPreAttributeChangeContainerInUse = false;
+	}
+}
+
+void UGMC_AbilitySystemComponent::BroadcastAttributeChange(const FAttribute& Attribute, float OldValue)
+{
+	OnAttributeChanged.Broadcast(Attribute.Tag, OldValue, Attribute.Value);
+	NativeAttributeChangeDelegate.Broadcast(Attribute.Tag, OldValue, Attribute.Value);
+	if (FOnAttributeValueChanged* Delegate = OnAttributeValueChangedDelegateMap.Find(Attribute.Tag))
+	{
+		Delegate->Broadcast(Attribute.Value);
+	}
+}
+
+void UGMC_AbilitySystemComponent::MarkAttributeDirty(int32 Node)
+{
+	if (!AttributeLayout || Node == INDEX_NONE) return;
+
+	if (Node < AttributeLayout->GetNumBound())
+	{
+		if (BoundAttributes.Attributes.IsValidIndex(Node))
+		{
+			BoundAttributes.MarkAttributeDirty(BoundAttributes.Attributes[Node]);
+		}
+		if (ChangedBoundAttributes.IsValidIndex(Node))
+		{
+			ChangedBoundAttributes[Node] = true;
+			bAnyBoundAttributeChanged = true;
+		}
+	}
+	else
+	{
+		UnBoundAttributes.MarkAttributeDirty(GetUnboundItemIndex(Node));
 	}
 }
 
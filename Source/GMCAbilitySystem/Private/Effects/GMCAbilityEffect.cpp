@@ -5,8 +5,57 @@
 
 #include "GMCAbilitySystem.h"
 #include "Components/GMCAbilityComponent.h"
+#include "Effects/GMCLightweightEffect.h"
 #include "Kismet/KismetSystemLibrary.h"
 
+namespace
+{
+	// Effect data fields sent as overrides through their property, in the same order on server and clients.
+	// Modifiers are sent by hand, their values being the fields most likely to be overridden.
+	const TArray<const FProperty*>& GetEffectDataOverrideProperties()
+	{
+		static const TArray<const FProperty*> Properties = []
+		{
+			const TSet<FName> SentSeparately = {
+				GET_MEMBER_NAME_CHECKED(FGMCAbilityEffectData, OwnerAbilityComponent),
+				GET_MEMBER_NAME_CHECKED(FGMCAbilityEffectData, EffectID),
+				GET_MEMBER_NAME_CHECKED(FGMCAbilityEffectData, StartTime),
+				GET_MEMBER_NAME_CHECKED(FGMCAbilityEffectData, EndTime),
+				GET_MEMBER_NAME_CHECKED(FGMCAbilityEffectData, Modifiers),
+			};
+
+			TArray<const FProperty*> Result;
+			for (TFieldIterator<FProperty> It(FGMCAbilityEffectData::StaticStruct()); It; ++It)
+			{
+				if (!SentSeparately.Contains(It->GetFName()))
+				{
+					Result.Add(*It);
+				}
+			}
+
+			// One bit per property plus one for the modifiers.
+			check(Result.Num() < 64);
+			return Result;
+		}();
+		return Properties;
+	}
+
+	bool AreModifiersEquivalentButValue(const FGMCAttributeModifier& A, const FGMCAttributeModifier& B)
+	{
+		return A.AttributeTag == B.AttributeTag && A.ModifierType == B.ModifierType && A.MetaTags == B.MetaTags;
+	}
+
+	bool AreModifiersIdentical(const TArray<FGMCAttributeModifier>& A, const TArray<FGMCAttributeModifier>& B)
+	{
+		if (A.Num() != B.Num()) return false;
+		for (int32 Index = 0; Index < A.Num(); ++Index)
+		{
+			if (A[Index].Value != B[Index].Value || !AreModifiersEquivalentButValue(A[Index], B[Index])) return false;
+		}
+		return true;
+	}
+}
+
 
 void UGMCAbilityEffect::InitializeEffect(FGMCAbilityEffectData InitializationData)
 {
@@ -45,83 +94,253 @@ void UGMCAbilityEffect::InitializeEffect(FGMCAbilityEffectData InitializationDat
 }
 
 
-void UGMCAbilityEffect::StartEffect()
+bool FGMCAbilityEffectData::NetSerializeOverrides(FArchive& Ar, UPackageMap* Map, const FGMCAbilityEffectData& Defaults)
 {
-	// Ensure tag requirements are met before applying the effect
-	if( ( EffectData.ApplicationMustHaveTags.Num() > 0 && !DoesOwnerHaveTagFromContainer(EffectData.ApplicationMustHaveTags) ) ||
-	DoesOwnerHaveTagFromContainer(EffectData.ApplicationMustNotHaveTags) ||
-	( EffectData.MustHaveTags.Num() > 0 && !DoesOwnerHaveTagFromContainer(EffectData.MustHaveTags) ) ||
-	DoesOwnerHaveTagFromContainer(EffectData.MustNotHaveTags) )
+	const TArray<const FProperty*>& Properties = GetEffectDataOverrideProperties();
+	const int32 ModifiersBit = Properties.Num();
+
+	uint64 OverrideMask = 0;
+	if (Ar.IsSaving())
 	{
-		EndEffect();
-		return;
+		for (int32 Index = 0; Index < Properties.Num(); ++Index)
+		{
+			if (!Properties[Index]->Identical_InContainer(this, &Defaults))
+			{
+				OverrideMask |= 1ull << Index;
+			}
+		}
+		if (!AreModifiersIdentical(Modifiers, Defaults.Modifiers))
+		{
+			OverrideMask |= 1ull << ModifiersBit;
+		}
 	}
+	Ar.SerializeBits(&OverrideMask, ModifiersBit + 1);
 
-	bHasStarted = true;
-	
-	AddTagsToOwner();
-	AddAbilitiesToOwner(EffectData.GrantedAbilities);
-	RemoveAbilitiesFromOwner(EffectData.RemovedAbilities);
-	EndActiveAbilitiesFromOwner();
-	OwnerAbilityComponent->DispelAbilityEffects(EffectData);
+	bool bSuccess = true;
+	for (int32 Index = 0; Index < Properties.Num(); ++Index)
+	{
+		if (OverrideMask & (1ull << Index))
+		{
+			bSuccess &= Properties[Index]->NetSerializeItem(Ar, Map, Properties[Index]->ContainerPtrToValuePtr<void>(this));
+		}
+	}
 
-	// Instant effects modify base value and end instantly
-	if (EffectData.bIsInstant)
+	if (!(OverrideMask & (1ull << ModifiersBit))) return bSuccess && !Ar.IsError();
+
+	uint32 NumModifiers = Modifiers.Num();
+	Ar.SerializeIntPacked(NumModifiers);
+	if (Ar.IsLoading())
 	{
-		for (const FGMCAttributeModifier& Modifier : EffectData.Modifiers)
+		// Effects don't come with that many modifiers, this is a corrupted stream.
+		if (NumModifiers > 1024)
 		{
-			OwnerAbilityComponent->ApplyAbilityEffectModifier(Modifier, true, false, EffectData.SourceAbilityComponent);
+			Ar.SetError();
+			return false;
+		}
+		Modifiers.SetNum(NumModifiers);
+	}
+
+	for (uint32 Index = 0; Index < NumModifiers; ++Index)
+	{
+		FGMCAttributeModifier& Modifier = Modifiers[Index];
+
+		// Most modifiers only differ from the defaults by their value
+		uint8 bOnlyValue = Ar.IsSaving() && Defaults.Modifiers.IsValidIndex(Index) && AreModifiersEquivalentButValue(Modifier, Defaults.Modifiers[Index]);
+		Ar.SerializeBits(&bOnlyValue, 1);
+
+		if (bOnlyValue)
+		{
+			if (Ar.IsLoading())
+			{
+				if (!Defaults.Modifiers.IsValidIndex(Index))
+				{
+					Ar.SetError();
+					return false;
+				}
+				Modifier = Defaults.Modifiers[Index];
+			}
+			Ar << Modifier.Value;
+			continue;
+		}
+
+		bool bTagSuccess = true;
+		Modifier.AttributeTag.NetSerialize(Ar, Map, bTagSuccess);
+		bSuccess &= bTagSuccess;
+		Ar << Modifier.Value;
+		Ar << Modifier.ModifierType;
+		Modifier.MetaTags.NetSerialize(Ar, Map, bTagSuccess);
+		bSuccess &= bTagSuccess;
+	}
+
+	return bSuccess && !Ar.IsError();
+}
+
+bool FGMCAbilityEffectData::DoesOwnerHaveTagFromContainer(const UGMC_AbilitySystemComponent& Owner, const FGameplayTagContainer& TagContainer)
+{
+	for (const FGameplayTag& Tag : TagContainer)
+	{
+		if (Owner.HasActiveTag(Tag))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FGMCAbilityEffectData::OwnerMeetsTagRequirements(const UGMC_AbilitySystemComponent& Owner) const
+{
+	return (MustHaveTags.Num() == 0 || DoesOwnerHaveTagFromContainer(Owner, MustHaveTags)) &&
+		!DoesOwnerHaveTagFromContainer(Owner, MustNotHaveTags);
+}
+
+bool FGMCAbilityEffectData::OwnerMeetsApplicationTagRequirements(const UGMC_AbilitySystemComponent& Owner) const
+{
+	return (ApplicationMustHaveTags.Num() == 0 || DoesOwnerHaveTagFromContainer(Owner, ApplicationMustHaveTags)) &&
+		!DoesOwnerHaveTagFromContainer(Owner, ApplicationMustNotHaveTags) &&
+		OwnerMeetsTagRequirements(Owner);
+}
+
+void FGMCAbilityEffectData::AddGrantedTagsToOwner(UGMC_AbilitySystemComponent& Owner) const
+{
+	if (bIsInstant)
+	{
+		for (const FGameplayTag& Tag : GrantedTags)
+		{
+			Owner.AddActiveTag(Tag);
 		}
-		StartEffect_Implementation();
-		EndEffect();
 		return;
 	}
 
+	Owner.AddEffectGrantedTags(GrantedTags);
+}
+
+void FGMCAbilityEffectData::RemoveGrantedTagsFromOwner(UGMC_AbilitySystemComponent& Owner) const
+{
+	// Tags stay as long as something else holds them (another effect, an ability...)
+	Owner.RemoveEffectGrantedTags(GrantedTags);
+}
+
+void FGMCAbilityEffectData::ApplyGrantsToOwner(UGMC_AbilitySystemComponent& Owner) const
+{
+	AddGrantedTagsToOwner(Owner);
+	for (const FGameplayTag& Tag : GrantedAbilities)
+	{
+		Owner.GrantAbilityByTag(Tag);
+	}
+	for (const FGameplayTag& Tag : RemovedAbilities)
+	{
+		Owner.RemoveGrantedAbilityByTag(Tag);
+	}
+	for (const FGameplayTag& Tag : CancelAbilityOnActivation)
+	{
+		Owner.EndAbilitiesByTag(Tag);
+	}
+}
+
+void FGMCAbilityEffectData::ApplyDurationModifiersToOwner(UGMC_AbilitySystemComponent& Owner, int32 RunningEffectID) const
+{
 	// Add one effect stack
-	if (EffectData.EffectStackAttributeTag.IsValid() && OwnerAbilityComponent->GetAttributeByTag(EffectData.EffectStackAttributeTag))
+	if (EffectStackAttributeTag.IsValid() && Owner.GetAttributeByTag(EffectStackAttributeTag))
 	{
 		FGMCAttributeModifier IncrementStack;
-		IncrementStack.AttributeTag = EffectData.EffectStackAttributeTag;
+		IncrementStack.AttributeTag = EffectStackAttributeTag;
 		IncrementStack.Value = 1.f;
 		IncrementStack.ModifierType = EModifierType::Add;
 
-		OwnerAbilityComponent->ApplyAbilityEffectModifier(IncrementStack, false, false, EffectData.SourceAbilityComponent);
+		Owner.ApplyAbilityEffectModifier(IncrementStack, false, false, SourceAbilityComponent);
 	}
 
 	// Duration Effects that aren't periodic alter modifiers, not base
-	if (!EffectData.bIsInstant && EffectData.Period == 0)
+	if (!bIsInstant && Period == 0)
 	{
-		EffectData.bNegateEffectAtEnd = true;
-		for (const FGMCAttributeModifier& Modifier : EffectData.Modifiers)
+		Owner.AddEffectModifiers(RunningEffectID, Modifiers, SourceAbilityComponent);
+	}
+}
+
+void FGMCAbilityEffectData::RevertFromOwner(UGMC_AbilitySystemComponent& Owner, int32 RunningEffectID, bool bRemoveModifiers) const
+{
+	// Revert stacks if there are no other stacks remaining
+	if (EffectStackAttributeTag.IsValid() && Owner.GetAttributeByTag(EffectStackAttributeTag) &&
+		!Owner.HasStartedEffectWithStackAttribute(EffectStackAttributeTag, RunningEffectID))
+	{
+		FGMCAttributeModifier ResetStacksModifier;
+		ResetStacksModifier.AttributeTag = EffectStackAttributeTag;
+		ResetStacksModifier.Value = Owner.GetAttributeValueByTag(EffectStackAttributeTag);
+		ResetStacksModifier.ModifierType = EModifierType::Add;
+
+		Owner.ApplyAbilityEffectModifier(ResetStacksModifier, false, true, SourceAbilityComponent);
+	}
+
+	if (bRemoveModifiers)
+	{
+		Owner.RemoveEffectModifiers(RunningEffectID);
+	}
+
+	// We only revert this if the effect was not instant.
+	if (!bIsInstant)
+	{
+		RemoveGrantedTagsFromOwner(Owner);
+		for (const FGameplayTag& Tag : RemovedAbilities)
 		{
-			OwnerAbilityComponent->ApplyAbilityEffectModifier(Modifier, false, false, EffectData.SourceAbilityComponent);
+			Owner.GrantAbilityByTag(Tag);
+		}
+		for (const FGameplayTag& Tag : GrantedAbilities)
+		{
+			Owner.RemoveGrantedAbilityByTag(Tag);
 		}
 	}
+}
 
-	StartEffect_Implementation();
 
-	// Tick period at start
-	if (EffectData.bPeriodTickAtStart && EffectData.Period > 0)
+#if WITH_EDITOR
+void UGMCAbilityEffect::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// Lightweight specs hold a copy of the class default effect data.
+	FGMCLightweightEffectSpec::InvalidateCache();
+}
+#endif
+
+
+void UGMCAbilityEffect::StartEffect()
+{
+	// Ensure tag requirements are met before applying the effect
+	if (!EffectData.OwnerMeetsApplicationTagRequirements(*OwnerAbilityComponent))
 	{
-		// This will force the initial period tick to automatically be triggered.
-		PrevPeriodMod = 1000000.f;
+		EndEffect();
+		return;
 	}
-				
-	// Instant effects instantly end
+
+	bHasStarted = true;
+	
+	EffectData.ApplyGrantsToOwner(*OwnerAbilityComponent);
+	OwnerAbilityComponent->DispelAbilityEffects(EffectData);
+
+	// Instant effects modify base value and end instantly
 	if (EffectData.bIsInstant)
 	{
+		OwnerAbilityComponent->ApplyAbilityEffectModifiers(EffectData.Modifiers, true, false, EffectData.SourceAbilityComponent);
+		StartEffect_Implementation();
 		EndEffect();
+		return;
 	}
 
-	UpdateState(EGMASEffectState::Started, true);
-
-	for (TPair<int, UGMCAbilityEffect*>& Data : OwnerAbilityComponent->GetActiveEffects())
+	if (EffectData.Period == 0)
 	{
-		if (IsValid(Data.Value) && Data.Value != this && Data.Value->CurrentState == EGMASEffectState::Started && Data.Value->EffectData.EffectTag == EffectData.EffectTag)
-		{
-			Data.Value->EndEffect();
-		}
+		EffectData.bNegateEffectAtEnd = true;
 	}
+	EffectData.ApplyDurationModifiersToOwner(*OwnerAbilityComponent, EffectData.EffectID);
+
+	StartEffect_Implementation();
+
+	// First period tick is due after the initial delay, or a period later unless ticking at start
+	NumPeriodsApplied = 0;
+	NextPeriodTime = EffectData.GetPeriodTime(EffectData.StartTime, 0);
+
+	UpdateState(EGMASEffectState::Started, true);
+
+	OwnerAbilityComponent->EndStartedEffectsWithTag(EffectData.EffectTag, EffectData.EffectID);
 }
 
 
@@ -139,49 +358,7 @@ void UGMCAbilityEffect::EndEffect()
 	// Only remove tags and abilities if the effect has started
 	if (!bHasStarted) return;
 
-	// Revert stacks if there are no other stacks remaining
-	if (EffectData.EffectStackAttributeTag.IsValid() && OwnerAbilityComponent->GetAttributeByTag(EffectData.EffectStackAttributeTag))
-	{
-		bool bResetStacks = true;
-		for (const TPair<int, UGMCAbilityEffect*> EffectPair : OwnerAbilityComponent->GetActiveEffects())
-		{
-			if (IsValid(EffectPair.Value) &&
-				EffectPair.Value != this &&
-				EffectPair.Value->CurrentState == EGMASEffectState::Started &&
-				EffectPair.Value->EffectData.EffectStackAttributeTag == EffectData.EffectStackAttributeTag)
-			{
-				bResetStacks = false;
-				break;
-			}
-		}
-
-		if (bResetStacks)
-		{
-			FGMCAttributeModifier ResetStacksModifier;
-			ResetStacksModifier.AttributeTag = EffectData.EffectStackAttributeTag;
-			ResetStacksModifier.Value = OwnerAbilityComponent->GetAttributeValueByTag(EffectData.EffectStackAttributeTag);
-			ResetStacksModifier.ModifierType = EModifierType::Add;
-
-			OwnerAbilityComponent->ApplyAbilityEffectModifier(ResetStacksModifier, false, true, EffectData.SourceAbilityComponent);
-		}
-		
-	}
-
-	if (EffectData.bNegateEffectAtEnd)
-	{
-		for (const FGMCAttributeModifier& Modifier : EffectData.Modifiers)
-		{
-			OwnerAbilityComponent->ApplyAbilityEffectModifier(Modifier, false, true, EffectData.SourceAbilityComponent);
-		}
-	}
-	
-	// We only revert this if the effect was not instant.
-	if (!EffectData.bIsInstant)
-	{
-		RemoveTagsFromOwner();
-		AddAbilitiesToOwner(EffectData.RemovedAbilities);
-		RemoveAbilitiesFromOwner(EffectData.GrantedAbilities);
-	}
+	EffectData.RevertFromOwner(*OwnerAbilityComponent, EffectData.EffectID, EffectData.bNegateEffectAtEnd);
 	EndEffect_Implementation();
 }
 
@@ -218,26 +395,77 @@ void UGMCAbilityEffect::Tick(float DeltaTime)
 	TickEvent(DeltaTime);
 	
 	// Ensure tag requirements are met before applying the effect
-	if( ( EffectData.MustHaveTags.Num() > 0 && !DoesOwnerHaveTagFromContainer(EffectData.MustHaveTags) ) ||
-		DoesOwnerHaveTagFromContainer(EffectData.MustNotHaveTags) )
+	CheckTagRequirements();
+
+	// If there's a period, check to see if it's time to tick. Periods due by the end time are applied before ending.
+	const double ActionTimer = OwnerAbilityComponent->ActionTimer;
+	const bool bReachedEndTime = EffectData.Duration != 0 && ActionTimer >= EffectData.EndTime;
+	if (ActionTimer >= NextPeriodTime || bReachedEndTime)
+	{
+		TickPeriod();
+	}
+	
+	CheckState();
+}
+
+bool UGMCAbilityEffect::HasPerFrameLogic(const UClass* EffectClass)
+{
+	// Native subclasses may override Tick.
+	const UClass* NativeClass = EffectClass;
+	while (NativeClass && !NativeClass->HasAnyClassFlags(CLASS_Native))
+	{
+		NativeClass = NativeClass->GetSuperClass();
+	}
+	if (NativeClass != StaticClass()) return true;
+
+	return EffectClass->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UGMCAbilityEffect, TickEvent));
+}
+
+void UGMCAbilityEffect::CheckTagRequirements()
+{
+	if (!bCompleted && !EffectData.OwnerMeetsTagRequirements(*OwnerAbilityComponent))
 	{
 		EndEffect();
 	}
+}
 
+void UGMCAbilityEffect::TickPeriod()
+{
+	if (EffectData.Period <= 0 || CurrentState != EGMASEffectState::Started) return;
 
-	// If there's a period, check to see if it's time to tick
-	if (!IsPeriodPaused() && EffectData.Period > 0 && CurrentState == EGMASEffectState::Started &&
-		OwnerAbilityComponent->ActionTimer >= EffectData.StartTime + EffectData.PeriodInitialDelay)
+	// Every period elapsed since the last tick is ticked, except those elapsed while paused. Each one runs the dynamic
+	// condition and the period event, as it would have with a tick per period.
+	const int32 NumPeriodsDue = EffectData.GetNumPeriodsDue(EffectData.StartTime, EffectData.EndTime, OwnerAbilityComponent->ActionTimer);
+	const int32 NumPeriodTicks = NumPeriodsDue - NumPeriodsApplied;
+	if (NumPeriodTicks > 0)
 	{
-		const float Mod = FMath::Fmod(OwnerAbilityComponent->ActionTimer - (EffectData.StartTime + EffectData.PeriodInitialDelay), EffectData.Period);
-		if (Mod <= PrevPeriodMod)
+		NumPeriodsApplied = NumPeriodsDue;
+		if (!IsPeriodPaused())
 		{
-			PeriodTick();
+			for (int32 PeriodIndex = 0; PeriodIndex < NumPeriodTicks && !bCompleted; ++PeriodIndex)
+			{
+				PeriodTick();
+			}
 		}
-		PrevPeriodMod = Mod;
 	}
-	
-	CheckState();
+	NextPeriodTime = EffectData.GetPeriodTime(EffectData.StartTime, NumPeriodsApplied);
+}
+
+float UGMCAbilityEffect::GetCurrentDuration() const
+{
+	// Effects driven by timers don't accumulate it every tick.
+	if (TimerSerial != 0 && OwnerAbilityComponent)
+	{
+		return OwnerAbilityComponent->ActionTimer - ClientEffectApplicationTime;
+	}
+	return EffectData.CurrentDuration;
+}
+
+FGMCAbilityEffectData UGMCAbilityEffect::GetEffectData() const
+{
+	FGMCAbilityEffectData Data = EffectData;
+	Data.CurrentDuration = GetCurrentDuration();
+	return Data;
 }
 
 void UGMCAbilityEffect::TickEvent_Implementation(float DeltaTime)
@@ -253,14 +481,35 @@ bool UGMCAbilityEffect::AttributeDynamicCondition_Implementation() const {
 void UGMCAbilityEffect::PeriodTick()
 {
 	if (AttributeDynamicCondition()) {
-		for (const FGMCAttributeModifier& AttributeModifier : EffectData.Modifiers)
-		{
-			OwnerAbilityComponent->ApplyAbilityEffectModifier(AttributeModifier, true, false, EffectData.SourceAbilityComponent);
-		}
+		OwnerAbilityComponent->ApplyAbilityEffectModifiers(EffectData.Modifiers, true, false, EffectData.SourceAbilityComponent);
 	}
 	PeriodTick_Implementation();
 }
 
+void UGMCAbilityEffect::ResetForReuse()
+{
+	// Properties, including Blueprint variables, go back to their defaults.
+	const UGMCAbilityEffect* CDO = GetClass()->GetDefaultObject<UGMCAbilityEffect>();
+	for (TFieldIterator<FProperty> It(GetClass()); It; ++It)
+	{
+		It->CopyCompleteValue_InContainer(this, CDO);
+	}
+
+	CurrentState = EGMASEffectState::Initialized;
+	bCompleted = false;
+	bHasStarted = false;
+	ClientEffectApplicationTime = 0.f;
+	TimerSerial = 0;
+	NumPeriodsApplied = 0;
+	NextPeriodTime = 0;
+
+	ResetEvent();
+}
+
+void UGMCAbilityEffect::ResetEvent_Implementation()
+{
+}
+
 void UGMCAbilityEffect::UpdateState(EGMASEffectState State, bool Force)
 {
 	if (State == EGMASEffectState::Ended)
@@ -268,6 +517,11 @@ void UGMCAbilityEffect::UpdateState(EGMASEffectState State, bool Force)
 	//	UE_LOG(LogGMCAbilitySystem, Warning, TEXT("Effect Ended"));
 	}
 
+	if (State != CurrentState && OwnerAbilityComponent)
+	{
+		OwnerAbilityComponent->NotifyEffectStateChanged(EffectData.EffectID, EffectData, CurrentState, State);
+	}
+
 	CurrentState = State;
 }
 
@@ -278,34 +532,12 @@ bool UGMCAbilityEffect::IsPeriodPaused()
 
 void UGMCAbilityEffect::AddTagsToOwner()
 {
-	for (const FGameplayTag Tag : EffectData.GrantedTags)
-	{
-		OwnerAbilityComponent->AddActiveTag(Tag);
-	}
+	EffectData.AddGrantedTagsToOwner(*OwnerAbilityComponent);
 }
 
 void UGMCAbilityEffect::RemoveTagsFromOwner(bool bPreserveOnMultipleInstances)
 {
-	if (EffectData.GrantedTags.Num() == 0)
-	{
-		return;
-	}
-
-	// We only remove tags which are not currently granted by other ability effects
-	FGameplayTagContainer TagsToRemove = EffectData.GrantedTags;
-	for (const TPair<int, UGMCAbilityEffect*> Effect : OwnerAbilityComponent->GetActiveEffects())
-	{
-		if (IsValid(Effect.Value) && Effect.Value->CurrentState == EGMASEffectState::Started
-								  && Effect.Value->EffectData.GrantedTags.HasAnyExact(TagsToRemove))
-		{
-			TagsToRemove.RemoveTags(Effect.Value->EffectData.GrantedTags);
-		}
-	}
-
-	for (const FGameplayTag Tag : TagsToRemove)
-	{
-		OwnerAbilityComponent->RemoveActiveTag(Tag);
-	}
+	EffectData.RemoveGrantedTagsFromOwner(*OwnerAbilityComponent);
 }
 
 void UGMCAbilityEffect::AddAbilitiesToOwner(const FGameplayTagContainer& TagsToAdd)
@@ -336,14 +568,7 @@ void UGMCAbilityEffect::EndActiveAbilitiesFromOwner() {
 
 bool UGMCAbilityEffect::DoesOwnerHaveTagFromContainer(FGameplayTagContainer& TagContainer) const
 {
-	for (const FGameplayTag Tag : TagContainer)
-	{
-		if (OwnerAbilityComponent->HasActiveTag(Tag))
-		{
-			return true;
-		}
-	}
-	return false;
+	return FGMCAbilityEffectData::DoesOwnerHaveTagFromContainer(*OwnerAbilityComponent, TagContainer);
 }
 
 bool UGMCAbilityEffect::DuplicateEffectAlreadyApplied()
@@ -0,0 +1,19 @@
+#include "Effects/GMCEffectScheduler.h"
+
+void FGMCEffectScheduler::Schedule(double Time, int32 EffectID, uint32 Serial, EGMCEffectTimerType Type)
+{
+	FGMCEffectTimer Timer;
+	Timer.Time = Time;
+	Timer.EffectID = EffectID;
+	Timer.Serial = Serial;
+	Timer.Type = Type;
+	Timers.HeapPush(Timer, FTimerOrder());
+}
+
+bool FGMCEffectScheduler::PopDue(double ActionTimer, FGMCEffectTimer& OutTimer)
+{
+	if (Timers.IsEmpty() || Timers.HeapTop().Time > ActionTimer) return false;
+
+	Timers.HeapPop(OutTimer, FTimerOrder());
+	return true;
+}
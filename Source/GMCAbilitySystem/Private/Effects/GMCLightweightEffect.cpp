@@ -0,0 +1,192 @@
+#include "Effects/GMCLightweightEffect.h"
+
+#include "GMCAbilitySystem.h"
+#include "Components/GMCAbilityComponent.h"
+
+namespace
+{
+	// Specs are never released, a null spec meaning that the class can't run as a lightweight effect.
+	TMap<FObjectKey, TSharedPtr<const FGMCLightweightEffectSpec>>& GetSpecCache()
+	{
+		static TMap<FObjectKey, TSharedPtr<const FGMCLightweightEffectSpec>> Cache;
+		return Cache;
+	}
+
+	bool CanRunLightweight(const UClass* EffectClass)
+	{
+		// Native subclasses may override any virtual function of the effect, which HasPerFrameLogic rules out.
+		return !UGMCAbilityEffect::HasPerFrameLogic(EffectClass)
+			&& !EffectClass->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UGMCAbilityEffect, AttributeDynamicCondition))
+			&& !EffectClass->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UGMCAbilityEffect, ResetEvent));
+	}
+}
+
+TSharedPtr<const FGMCLightweightEffectSpec> FGMCLightweightEffectSpec::Get(TSubclassOf<UGMCAbilityEffect> EffectClass)
+{
+	check(IsInGameThread());
+
+	if (EffectClass == nullptr) return nullptr;
+
+	const UGMCAbilityEffect* CDO = EffectClass->GetDefaultObject<UGMCAbilityEffect>();
+	if (CDO == nullptr || !CDO->bLightweight) return nullptr;
+
+	const FObjectKey Key(EffectClass.Get());
+	if (const TSharedPtr<const FGMCLightweightEffectSpec>* CachedSpec = GetSpecCache().Find(Key))
+	{
+		return *CachedSpec;
+	}
+
+	TSharedPtr<FGMCLightweightEffectSpec> Spec;
+	if (CanRunLightweight(EffectClass))
+	{
+		Spec = MakeShared<FGMCLightweightEffectSpec>();
+		Spec->EffectClass = EffectClass;
+		Spec->Data = CDO->EffectData;
+	}
+	else
+	{
+		UE_LOG(LogGMCAbilitySystem, Warning, TEXT("Effect %s is flagged lightweight but has native code or Blueprint events, it will be applied as an effect object."), *GetNameSafe(EffectClass));
+	}
+
+	GetSpecCache().Add(Key, Spec);
+	return Spec;
+}
+
+void FGMCLightweightEffectSpec::InvalidateCache()
+{
+	GetSpecCache().Reset();
+}
+
+FGMCAbilityEffectData FGMCLightweightEffect::MakeEffectData(UGMC_AbilitySystemComponent* OwnerAbilityComponent) const
+{
+	FGMCAbilityEffectData EffectData = Spec->Data;
+	EffectData.OwnerAbilityComponent = OwnerAbilityComponent;
+	EffectData.EffectID = EffectID;
+	EffectData.StartTime = StartTime;
+	EffectData.EndTime = EndTime;
+	EffectData.CurrentDuration = OwnerAbilityComponent ? GetCurrentDuration(OwnerAbilityComponent->ActionTimer) : 0;
+	EffectData.bNegateEffectAtEnd = bHasStarted && !EffectData.bIsInstant && EffectData.Period == 0;
+	return EffectData;
+}
+
+void FGMCLightweightEffect::CheckState(UGMC_AbilitySystemComponent& Owner)
+{
+	switch (CurrentState)
+	{
+		case EGMASEffectState::Initialized:
+			if (Owner.ActionTimer >= StartTime)
+			{
+				StartEffect(Owner);
+			}
+			break;
+		case EGMASEffectState::Started:
+			if (GetData().Duration != 0 && Owner.ActionTimer >= EndTime)
+			{
+				EndEffect(Owner);
+			}
+			break;
+		default: break;
+	}
+}
+
+void FGMCLightweightEffect::CheckTagRequirements(UGMC_AbilitySystemComponent& Owner)
+{
+	if (bCompleted) return;
+
+	if (!GetData().OwnerMeetsTagRequirements(Owner))
+	{
+		EndEffect(Owner);
+	}
+}
+
+void FGMCLightweightEffect::TickPeriod(UGMC_AbilitySystemComponent& Owner)
+{
+	const FGMCAbilityEffectData& Data = GetData();
+	if (CurrentState != EGMASEffectState::Started || Data.Period <= 0) return;
+
+	// Every period elapsed since the last tick is applied at once, except those elapsed while paused. Lightweight effects
+	// have no dynamic condition nor period event to run per period.
+	const int32 NumPeriodsDue = Data.GetNumPeriodsDue(StartTime, EndTime, Owner.ActionTimer);
+	const int32 NumPeriodTicks = NumPeriodsDue - NumPeriodsApplied;
+	if (NumPeriodTicks > 0)
+	{
+		NumPeriodsApplied = NumPeriodsDue;
+		if (!FGMCAbilityEffectData::DoesOwnerHaveTagFromContainer(Owner, Data.PausePeriodicEffect))
+		{
+			PeriodTick(Owner, NumPeriodTicks);
+		}
+	}
+	NextPeriodTime = Data.GetPeriodTime(StartTime, NumPeriodsApplied);
+}
+
+void FGMCLightweightEffect::StartEffect(UGMC_AbilitySystemComponent& Owner)
+{
+	const FGMCAbilityEffectData& Data = GetData();
+
+	// Ensure tag requirements are met before applying the effect
+	if (!Data.OwnerMeetsApplicationTagRequirements(Owner))
+	{
+		EndEffect(Owner);
+		return;
+	}
+
+	bHasStarted = true;
+	UpdateState(Owner, EGMASEffectState::Started);
+
+	Data.ApplyGrantsToOwner(Owner);
+	Owner.DispelAbilityEffects(MakeEffectData(&Owner));
+
+	// Instant effects modify base value and end instantly
+	if (Data.bIsInstant)
+	{
+		Owner.ApplyAbilityEffectModifiers(Data.Modifiers, true, false, Data.SourceAbilityComponent);
+		EndEffect(Owner);
+		return;
+	}
+
+	Data.ApplyDurationModifiersToOwner(Owner, EffectID);
+
+	// First period tick is due after the initial delay, or a period later unless ticking at start
+	if (Data.Period > 0)
+	{
+		NumPeriodsApplied = 0;
+		NextPeriodTime = Data.GetPeriodTime(StartTime, 0);
+	}
+
+	Owner.EndStartedEffectsWithTag(Data.EffectTag, EffectID);
+}
+
+void FGMCLightweightEffect::EndEffect(UGMC_AbilitySystemComponent& Owner)
+{
+	// Prevent EndEffect from being called multiple times
+	if (bCompleted) return;
+
+	bCompleted = true;
+	UpdateState(Owner, EGMASEffectState::Ended);
+
+	// Only remove tags and abilities if the effect has started
+	if (!bHasStarted) return;
+
+	const FGMCAbilityEffectData& Data = GetData();
+	Data.RevertFromOwner(Owner, EffectID, !Data.bIsInstant && Data.Period == 0);
+}
+
+void FGMCLightweightEffect::UpdateState(UGMC_AbilitySystemComponent& Owner, EGMASEffectState State)
+{
+	if (State != CurrentState)
+	{
+		Owner.NotifyEffectStateChanged(EffectID, GetData(), CurrentState, State);
+	}
+	CurrentState = State;
+}
+
+void FGMCLightweightEffect::PeriodTick(UGMC_AbilitySystemComponent& Owner, int32 NumPeriodTicks)
+{
+	Owner.ApplyAbilityEffectModifiers(GetData().Modifiers, true, false, GetData().SourceAbilityComponent, NumPeriodTicks);
+}
+
+FString FGMCLightweightEffect::ToString(double ActionTimer) const
+{
+	return FString::Printf(TEXT("[lightweight: %s] (State %s) | Started: %d | Data: [id: %d] [Tag: %s] (Duration: %.3lf) (CurrentDuration: %.3lf)"),
+		*GetNameSafe(Spec->EffectClass), *EnumToString(CurrentState), bHasStarted, EffectID, *GetData().EffectTag.ToString(), GetData().Duration, GetCurrentDuration(ActionTimer));
+}
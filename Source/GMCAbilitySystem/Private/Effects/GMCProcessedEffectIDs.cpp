@@ -0,0 +1,66 @@
+#include "Effects/GMCProcessedEffectIDs.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Processed Effect IDs"), STAT_GMASProcessedEffectIDs, STATGROUP_Game);
+
+FGMCProcessedEffectIDs::~FGMCProcessedEffectIDs()
+{
+	DEC_DWORD_STAT_BY(STAT_GMASProcessedEffectIDs, ServerConfirmed.Num());
+}
+
+void FGMCProcessedEffectIDs::Add(int32 EffectID, bool bServerConfirmed, double ActionTimer)
+{
+	if (bool* bKnownServerConfirmed = ServerConfirmed.Find(EffectID))
+	{
+		*bKnownServerConfirmed = bServerConfirmed;
+		return;
+	}
+
+	if (MaxNum > 0 && ServerConfirmed.Num() >= MaxNum)
+	{
+		// Every ID pending confirmation is passed over at most once.
+		for (int32 NumTries = Entries.Num() - FirstEntry; NumTries > 0 && !ForgetOldest(ActionTimer); --NumTries)
+		{
+		}
+	}
+
+	ServerConfirmed.Add(EffectID, bServerConfirmed);
+	Entries.Add({EffectID, ActionTimer});
+	INC_DWORD_STAT(STAT_GMASProcessedEffectIDs);
+}
+
+void FGMCProcessedEffectIDs::Expire(double ActionTimer)
+{
+	// IDs queued again are as of this ActionTimer, they stop the loop.
+	while (FirstEntry < Entries.Num() && Entries[FirstEntry].Time < ActionTimer - Window)
+	{
+		ForgetOldest(ActionTimer);
+	}
+}
+
+bool FGMCProcessedEffectIDs::ForgetOldest(double ActionTimer)
+{
+	if (FirstEntry >= Entries.Num()) return false;
+
+	const int32 EffectID = Entries[FirstEntry].EffectID;
+	++FirstEntry;
+
+	const bool bPendingConfirmation = !ServerConfirmed.FindRef(EffectID) && IsEffectActive && IsEffectActive(EffectID);
+	if (bPendingConfirmation)
+	{
+		Entries.Add({EffectID, ActionTimer});
+	}
+	else
+	{
+		ServerConfirmed.Remove(EffectID);
+		DEC_DWORD_STAT(STAT_GMASProcessedEffectIDs);
+	}
+
+	// Only move the remaining entries once the forgotten ones make up most of the array.
+	if (FirstEntry > 32 && FirstEntry * 2 > Entries.Num())
+	{
+		Entries.RemoveAt(0, FirstEntry);
+		FirstEntry = 0;
+	}
+
+	return !bPendingConfirmation;
+}
@@ -248,8 +248,8 @@ private:
 	UPROPERTY()
 	TArray<TObjectPtr<UGameplayTask>> ActiveTasks;
 
-	UPROPERTY()
-	UGMCAbilityEffect* AbilityCostInstance = nullptr;
+	// ID of the cost effect applied by CommitAbilityCost, 0 if none. Effects are pooled, their pointers can't be kept.
+	int AbilityCostEffectID = 0;
 
 	bool IsOnCooldown() const;
 
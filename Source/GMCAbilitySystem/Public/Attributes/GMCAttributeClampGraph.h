@@ -0,0 +1,51 @@
+#pragma once
+#include "GameplayTagContainer.h"
+
+struct FAttributeClamp;
+
+/**
+ * Compiled form of the Min/MaxAttributeTag relationships between the attributes of an ability component.
+ * Attributes are referenced by node index, which is assigned by the owner (see FGMCAttributeLayout).
+ * For every attribute, the graph stores all attributes transitively clamped by it, in topological order,
+ * so that a change can be propagated in a single ordered pass.
+ */
+struct GMCABILITYSYSTEM_API FGMCAttributeClampGraph
+{
+	/**
+	 * Compile the graph.
+	 * @param NumNodes Number of attributes.
+	 * @param GetTag Returns the tag of the attribute of a node.
+	 * @param GetClamp Returns the clamp of the attribute of a node.
+	 * @param ResolveNode Returns the node of the attribute matching a tag, INDEX_NONE if there is none.
+	 * Attributes which are part of a clamp cycle are reported and excluded from propagation.
+	 */
+	void Build(int32 NumNodes, TFunctionRef<const FGameplayTag&(int32)> GetTag, TFunctionRef<const FAttributeClamp&(int32)> GetClamp,
+		TFunctionRef<int32(const FGameplayTag&)> ResolveNode);
+
+	void Reset();
+
+	int32 Num() const { return MinSource.Num(); }
+
+	// Node clamping the minimum/maximum of a node, INDEX_NONE if none.
+	int32 GetMinSource(int32 Node) const { return MinSource[Node]; }
+	int32 GetMaxSource(int32 Node) const { return MaxSource[Node]; }
+
+	// Position of a node in the topological order, INDEX_NONE for nodes part of a cycle.
+	int32 GetRank(int32 Node) const { return Rank[Node]; }
+
+	// Every node transitively clamped by a node, sorted so that a node always comes after its clamp sources.
+	TConstArrayView<int32> GetDependents(int32 Node) const
+	{
+		if (!DependentOffsets.IsValidIndex(Node + 1)) return {};
+		return TConstArrayView<int32>(Dependents.GetData() + DependentOffsets[Node], DependentOffsets[Node + 1] - DependentOffsets[Node]);
+	}
+
+private:
+	TArray<int32> MinSource;
+	TArray<int32> MaxSource;
+	TArray<int32> Rank;
+
+	// Dependents of node N are Dependents[DependentOffsets[N]] to Dependents[DependentOffsets[N + 1]] excluded.
+	TArray<int32> DependentOffsets;
+	TArray<int32> Dependents;
+};
@@ -0,0 +1,62 @@
+#pragma once
+#include "GameplayTagContainer.h"
+
+/**
+ * Fixed capacity ring buffer of attribute values and active tags, one snapshot per prediction tick.
+ * Attributes are stored by slot of the attribute layout. Tags are stored as bits, each tag getting a bit the first
+ * time it's recorded, so that recording a snapshot never allocates once every tag in use has been seen.
+ * Snapshots are ordered by time: recording at a time older than the latest snapshot (a client replaying moves after
+ * a correction) discards every snapshot at or after that time first.
+ */
+struct GMCABILITYSYSTEM_API FGMCAttributeHistory
+{
+	// Number of distinct tags a history can record. Tags seen after that are ignored.
+	static constexpr int32 NumTagWords = 4;
+	static constexpr int32 MaxRecordedTags = NumTagWords * 64;
+
+	// Allocate the buffer. A capacity of 0 disables the history.
+	void Init(int32 InCapacity, int32 InNumAttributes);
+
+	void Reset();
+
+	bool IsEnabled() const { return Capacity > 0; }
+	int32 Num() const { return Count; }
+
+	/**
+	 * Record a snapshot, returning the values of its attributes, by slot, for the caller to fill.
+	 * Returns an empty view if the history is disabled.
+	 */
+	TArrayView<float> Record(double Time, const FGameplayTagContainer& ActiveTags);
+
+	// Value of an attribute at a time, interpolated between the surrounding snapshots.
+	// Times after the latest snapshot use the latest one. Returns false if the time isn't covered by the history.
+	bool SampleValue(int32 Slot, double Time, float& OutValue) const;
+
+	// Whether a tag (or one of its children unless bExact) was active at a time, according to the latest snapshot
+	// recorded at or before it. Returns false if the time isn't covered by the history.
+	bool SampleTag(const FGameplayTag& Tag, double Time, bool bExact, bool& bOutActive) const;
+
+private:
+	// Index in the buffers of the Nth oldest snapshot.
+	int32 GetBufferIndex(int32 Age) const { return (Head - Count + Age + Capacity) % Capacity; }
+
+	// Age of the latest snapshot recorded at or before a time, INDEX_NONE if there's none. Binary search.
+	int32 FindSnapshot(double Time) const;
+
+	int32 Capacity = 0;
+	int32 NumAttributes = 0;
+
+	// Buffer index the next snapshot is written at, and number of valid snapshots.
+	int32 Head = 0;
+	int32 Count = 0;
+
+	TArray<double> Times;
+	// NumAttributes values per snapshot.
+	TArray<float> Values;
+	// NumTagWords words per snapshot, bit N being RecordedTags[N].
+	TArray<uint64> TagBits;
+
+	TArray<FGameplayTag> RecordedTags;
+	TMap<FGameplayTag, int32> RecordedTagIndices;
+	bool bReportedTagOverflow = false;
+};
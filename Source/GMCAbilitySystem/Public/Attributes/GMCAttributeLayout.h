@@ -0,0 +1,130 @@
+#pragma once
+#include "GameplayTagContainer.h"
+#include "GMCAttributeClamp.h"
+#include "GMCAttributeClampGraph.h"
+#include "GMCAttributeModifier.h"
+#include "GMCAttributeQuantization.h"
+#include "UObject/ObjectKey.h"
+
+class UGMCAttributesData;
+
+// Parts of the numeric state of an attribute, as bound to the GMC.
+enum class EGMCAttributeChannel : uint8
+{
+	BaseValue,
+	Value,
+	AdditiveModifier,
+	MultiplyModifier,
+	DivisionModifier
+};
+
+// Static description of one attribute, shared by every component using the same layout.
+struct GMCABILITYSYSTEM_API FGMCAttributeLayoutEntry
+{
+	FGameplayTag Tag;
+	float DefaultValue = 0.f;
+
+	// Clamp as authored. Its AbilityComponent is always null, components set their own on their attributes.
+	FAttributeClamp Clamp;
+
+	FGameplayTag RegenAttributeTag;
+	FGameplayTagContainer RegenBlockingTags;
+
+	bool bIsGMCBound = false;
+	FGMCAttributeQuantization Quantization;
+	EGMCAttributeModifierChannel ModifierChannels = EGMCAttributeModifierChannel::All;
+
+	bool IsModifierChannelBound(EGMCAttributeModifierChannel Channel) const
+	{
+		return !bIsGMCBound || EnumHasAllFlags(ModifierChannels, Channel);
+	}
+};
+
+// Location of a quantized channel of a bound attribute inside a component's quantized words.
+struct GMCABILITYSYSTEM_API FGMCQuantizedAttributeChannel
+{
+	int32 Slot = INDEX_NONE;
+	EGMCAttributeChannel Channel = EGMCAttributeChannel::Value;
+	EGMCAttributePrecision Codec = EGMCAttributePrecision::Full;
+	int32 Word = INDEX_NONE;
+	// 16 bit codecs share words, this is the bit offset in the word.
+	uint8 Shift = 0;
+};
+
+// Attribute regenerated natively every prediction tick, at the rate given by the value of another attribute.
+struct GMCABILITYSYSTEM_API FGMCAttributeRegen
+{
+	int32 Slot = INDEX_NONE;
+	int32 RateSlot = INDEX_NONE;
+};
+
+/**
+ * Immutable attribute layout compiled from a list of UGMCAttributesData, shared by every component using the same list.
+ * Attributes are identified by slot: bound attributes come first, in binding order, followed by unbound ones.
+ * Bound slots match indices in FGMCAttributeSet::Attributes. Unbound slots minus NumBound match indices in
+ * FGMCUnboundAttributeSet::Items on the server, clients remap them as items replicate in any order.
+ */
+class GMCABILITYSYSTEM_API FGMCAttributeLayout
+{
+public:
+	// Get the layout for a list of data assets, compiling it if no component currently uses it.
+	static TSharedRef<const FGMCAttributeLayout> Get(TConstArrayView<UGMCAttributesData*> DataAssets);
+
+	// Forget every cached layout, e.g. when a data asset is edited. Layouts still in use stay valid.
+	static void InvalidateCache();
+
+	/**
+	 * Binding order of bound attributes, by tag name. Names are compared in place: this doesn't allocate, and unlike
+	 * FName indices it gives the same order on every machine, which is required for client and server to bind alike.
+	 */
+	static bool IsBoundBefore(const FGameplayTag& A, const FGameplayTag& B)
+	{
+		return A.GetTagName().Compare(B.GetTagName()) < 0;
+	}
+
+	int32 Num() const { return Entries.Num(); }
+	int32 GetNumBound() const { return NumBound; }
+	int32 GetNumUnbound() const { return Entries.Num() - NumBound; }
+
+	const FGMCAttributeLayoutEntry& GetEntry(int32 Slot) const { return Entries[Slot]; }
+
+	// Default value of every attribute, by slot. Kept apart from the entries so that bulk reads stay contiguous.
+	TConstArrayView<float> GetDefaultValues() const { return DefaultValues; }
+	float GetDefaultValue(int32 Slot) const { return DefaultValues[Slot]; }
+	TConstArrayView<FGMCAttributeLayoutEntry> GetEntries() const { return Entries; }
+
+	// Slot of the attribute matching a tag, INDEX_NONE if none. Unbound attributes take priority on duplicated tags.
+	int32 FindSlot(const FGameplayTag& Tag) const
+	{
+		const int32* Slot = SlotByTag.Find(Tag);
+		return Slot ? *Slot : INDEX_NONE;
+	}
+
+	// Clamp relationships between attributes, nodes are slots.
+	const FGMCAttributeClampGraph& GetClampGraph() const { return ClampGraph; }
+
+	// Channels of quantized bound attributes and the number of words they are packed into.
+	TConstArrayView<FGMCQuantizedAttributeChannel> GetQuantizedChannels() const { return QuantizedChannels; }
+	int32 GetNumQuantizedWords() const { return NumQuantizedWords; }
+
+	// Bound attributes with a valid regen source, in slot order.
+	TConstArrayView<FGMCAttributeRegen> GetRegens() const { return Regens; }
+
+	// Every tag blocking the regen of at least one attribute. If none is active, no regen is blocked.
+	const FGameplayTagContainer& GetAllRegenBlockingTags() const { return AllRegenBlockingTags; }
+
+private:
+	void Build(TConstArrayView<UGMCAttributesData*> DataAssets);
+	void BuildQuantizedChannels();
+	void BuildRegens();
+
+	TArray<FGMCAttributeLayoutEntry> Entries;
+	int32 NumBound = 0;
+	TArray<float> DefaultValues;
+	TMap<FGameplayTag, int32> SlotByTag;
+	FGMCAttributeClampGraph ClampGraph;
+	TArray<FGMCQuantizedAttributeChannel> QuantizedChannels;
+	int32 NumQuantizedWords = 0;
+	TArray<FGMCAttributeRegen> Regens;
+	FGameplayTagContainer AllRegenBlockingTags;
+};
@@ -13,6 +13,28 @@ enum class EModifierType : uint8
 	Divide     
 };
 
+// Modifier channels of an attribute, i.e. what duration modifiers of each EModifierType accumulate into.
+UENUM(BlueprintType, meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class EGMCAttributeModifierChannel : uint8
+{
+	None = 0 UMETA(Hidden),
+	Additive = 1 << 0,
+	Multiply = 1 << 1,
+	Divide = 1 << 2,
+	All = Additive | Multiply | Divide UMETA(Hidden)
+};
+ENUM_CLASS_FLAGS(EGMCAttributeModifierChannel);
+
+inline EGMCAttributeModifierChannel GetModifierChannel(EModifierType ModifierType)
+{
+	switch (ModifierType)
+	{
+	case EModifierType::Multiply: return EGMCAttributeModifierChannel::Multiply;
+	case EModifierType::Divide: return EGMCAttributeModifierChannel::Divide;
+	default: return EGMCAttributeModifierChannel::Additive;
+	}
+}
+
 USTRUCT(BlueprintType)
 struct FGMCAttributeModifier
 {
@@ -33,4 +55,21 @@ struct FGMCAttributeModifier
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "GMCAbilitySystem")
 	FGameplayTagContainer MetaTags;
 	
-};
\ No newline at end of file
+};
+
+// Contribution of an active effect to a modifier channel of an attribute.
+USTRUCT(BlueprintType)
+struct FGMCAttributeModifierContribution
+{
+	GENERATED_BODY()
+
+	// Effect the modifier comes from, INDEX_NONE for modifiers applied without an effect.
+	UPROPERTY(BlueprintReadOnly, Category = "GMCAbilitySystem")
+	int32 EffectID{INDEX_NONE};
+
+	UPROPERTY(BlueprintReadOnly, Category = "GMCAbilitySystem")
+	EModifierType ModifierType{EModifierType::Add};
+
+	UPROPERTY(BlueprintReadOnly, Category = "GMCAbilitySystem")
+	float Value{0};
+};
@@ -0,0 +1,66 @@
+#pragma once
+#include "GMCAttributeModifier.h"
+
+/**
+ * Modifier channels of every attribute of a component, kept as the sum of their contributions.
+ * Duration effects register their modifiers under their effect ID and remove them with it, which takes out exactly
+ * what was added instead of applying the negated modifiers. A channel without any effect contribution is reset to
+ * its exact identity, so rounding errors can't build up over the lifetime of the component.
+ * Modifiers applied without an effect (e.g. effect stacks) are accumulated apart. When they must be rolled back by the
+ * GMC, the owner keeps their sum itself and passes it in, the channel still being rebuilt from it and the effect sums.
+ * Attributes are referenced by slot of the attribute layout.
+ */
+struct GMCABILITYSYSTEM_API FGMCAttributeModifierAggregator
+{
+	static constexpr int32 NumChannels = 3;
+
+	struct FEffectModifier
+	{
+		int32 Slot;
+		EModifierType ModifierType;
+		float Value;
+	};
+	using FEffectModifiers = TArray<FEffectModifier, TInlineAllocator<4>>;
+
+	void Init(int32 NumAttributes);
+
+	// Add the modifier of an effect to an attribute.
+	void Add(int32 EffectID, int32 Slot, EModifierType ModifierType, float Value);
+
+	// Add a modifier which doesn't belong to any effect.
+	void AddUnowned(int32 Slot, EModifierType ModifierType, float Value);
+
+	/**
+	 * Remove every modifier of an effect.
+	 * @param OutModifiers Modifiers the effect had added.
+	 */
+	void Remove(int32 EffectID, FEffectModifiers& OutModifiers);
+
+	// Forget every modifier of a channel of an attribute.
+	void ResetChannel(int32 Slot, EModifierType ModifierType);
+
+	// Current value of a modifier channel of an attribute.
+	float GetChannelValue(int32 Slot, EModifierType ModifierType) const;
+
+	// Current value of a modifier channel whose modifiers without an effect are summed outside the aggregator.
+	float GetChannelValue(int32 Slot, EModifierType ModifierType, double UnownedSum) const;
+
+	// Contributions to the modifiers of an attribute, unowned modifiers being grouped under INDEX_NONE.
+	void GetContributions(int32 Slot, TArray<FGMCAttributeModifierContribution>& OutContributions) const;
+
+	bool HasEffect(int32 EffectID) const { return ModifiersByEffect.Contains(EffectID); }
+
+	static int32 GetChannelIndex(EModifierType ModifierType) { return FMath::Clamp(static_cast<int32>(ModifierType), 0, NumChannels - 1); }
+
+private:
+	struct FChannelSums
+	{
+		// Sum and number of effect contributions, summed as doubles.
+		double EffectSum[NumChannels] = {0, 0, 0};
+		int32 NumEffectModifiers[NumChannels] = {0, 0, 0};
+		double UnownedSum[NumChannels] = {0, 0, 0};
+	};
+
+	TArray<FChannelSums> Sums;
+	TMap<int32, FEffectModifiers> ModifiersByEffect;
+};
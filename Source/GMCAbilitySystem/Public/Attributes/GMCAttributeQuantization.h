@@ -0,0 +1,71 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "GMCAttributeQuantization.generated.h"
+
+UENUM(BlueprintType)
+enum class EGMCAttributePrecision : uint8
+{
+	// 32 bit float, bound as is.
+	Full,
+	// 16 bit float. Around 3 significant digits, fine for small values or values which don't need to be exact.
+	Half,
+	// 16 bit fixed point, values are stored as a whole number of steps from an origin.
+	FixedPoint,
+	// Rounded to the nearest whole number, stored on 32 bits. Multiply/Divide modifiers are stored as 16 bit floats.
+	Integer
+};
+
+/**
+ * How a GMC bound attribute is represented in the move history.
+ * Anything other than Full makes the attribute values snap to the representable grid every move, on both the client
+ * and the server, so pick a precision finer than the smallest change an attribute can receive in a single move.
+ */
+USTRUCT(BlueprintType)
+struct GMCABILITYSYSTEM_API FGMCAttributeQuantization
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditDefaultsOnly, Category = "GMCAbilitySystem")
+	EGMCAttributePrecision Precision{EGMCAttributePrecision::Full};
+
+	// Value represented by 0 steps. Base value and value can go 32767 steps either way of it.
+	UPROPERTY(EditDefaultsOnly, Category = "GMCAbilitySystem", meta = (EditCondition = "Precision == EGMCAttributePrecision::FixedPoint", EditConditionHides))
+	float FixedPointOrigin{0.f};
+
+	// Smallest representable change.
+	UPROPERTY(EditDefaultsOnly, Category = "GMCAbilitySystem", meta = (EditCondition = "Precision == EGMCAttributePrecision::FixedPoint", EditConditionHides, ClampMin = "0.0001"))
+	float FixedPointStep{0.01f};
+
+	bool IsQuantized() const { return Precision != EGMCAttributePrecision::Full; }
+
+	static uint16 EncodeHalf(float Value)
+	{
+		const FFloat16 Half(Value);
+		return Half.Encoded;
+	}
+
+	static float DecodeHalf(uint16 Bits)
+	{
+		FFloat16 Half;
+		Half.Encoded = Bits;
+		return Half.GetFloat();
+	}
+
+	static uint16 EncodeFixedPoint(float Value, float Origin, float Step)
+	{
+		const int32 Steps = FMath::Clamp(FMath::RoundToInt((Value - Origin) / Step), static_cast<int32>(MIN_int16), static_cast<int32>(MAX_int16));
+		return static_cast<uint16>(static_cast<int16>(Steps));
+	}
+
+	static float DecodeFixedPoint(uint16 Bits, float Origin, float Step)
+	{
+		return Origin + static_cast<int16>(Bits) * Step;
+	}
+
+	static int32 EncodeInteger(float Value)
+	{
+		// Largest float below 2^31, anything past it wouldn't fit.
+		constexpr float Limit = 2147483520.f;
+		return FMath::RoundToInt(FMath::Clamp(Value, -Limit, Limit));
+	}
+};
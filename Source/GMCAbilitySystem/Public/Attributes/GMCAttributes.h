@@ -1,7 +1,9 @@
 #pragma once
 #include "GameplayTagContainer.h"
 #include "GMCAttributeClamp.h"
+#include "GMCAttributeLayout.h"
 #include "Effects/GMCAbilityEffect.h"
+#include "Algo/BinarySearch.h"
 #include "Net/Serialization/FastArraySerializer.h"
 #include "GMCAttributes.generated.h"
 
@@ -9,6 +11,104 @@ class UGMC_AbilitySystemComponent;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FAttributeChanged, float, OldValue, float, NewValue);
 
+/**
+ * Resolved reference to an attribute of an ability component.
+ * Resolve it once with UGMC_AbilitySystemComponent::GetAttributeHandle, then use it to read the attribute directly
+ * instead of going through a tag lookup every time.
+ * If the attribute layout changes after resolution, the handle will fall back on its tag.
+ */
+USTRUCT(BlueprintType)
+struct GMCABILITYSYSTEM_API FGMCAttributeHandle
+{
+	GENERATED_BODY()
+
+	FGMCAttributeHandle() {}
+
+	FGMCAttributeHandle(const FGameplayTag& InTag, bool bInIsGMCBound, int32 InIndex, uint32 InLayoutSerial)
+		: Tag(InTag), bIsGMCBound(bInIsGMCBound), Index(InIndex), LayoutSerial(InLayoutSerial) {}
+
+	// Tag of the attribute this handle was resolved from.
+	UPROPERTY(BlueprintReadOnly, Category = "GMCAbilitySystem")
+	FGameplayTag Tag{FGameplayTag::EmptyTag};
+
+	// Whether the attribute is in the bound or the unbound attribute set.
+	UPROPERTY()
+	bool bIsGMCBound = false;
+
+	// Slot of the attribute in the component's attribute layout.
+	UPROPERTY()
+	int32 Index = INDEX_NONE;
+
+	// Serial of the attribute instantiation this handle was resolved against.
+	UPROPERTY()
+	uint32 LayoutSerial = 0;
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+};
+
+/**
+ * Structure-of-arrays storage for the numeric state of an attribute set.
+ * When a set uses column storage, its FAttribute entries become thin views over these columns:
+ * the columns are the authoritative state (and what gets bound to the GMC), the inline fields of FAttribute are
+ * only mirrors kept up to date for Blueprint and debugging purposes.
+ */
+struct GMCABILITYSYSTEM_API FGMCAttributeColumns
+{
+	TArray<float> BaseValue;
+	TArray<float> AdditiveModifier;
+	TArray<float> MultiplyModifier;
+	TArray<float> DivisionModifier;
+	TArray<float> Value;
+
+	// Static clamp range of each attribute. Attributes without a static clamp use the full float range.
+	TArray<float> ClampMin;
+	TArray<float> ClampMax;
+
+	// Attributes clamped by another attribute's value, which cannot be part of the batched pass.
+	TArray<int32> DynamicClampIndices;
+
+	int32 Num() const { return Value.Num(); }
+
+	void Reset()
+	{
+		BaseValue.Reset();
+		AdditiveModifier.Reset();
+		MultiplyModifier.Reset();
+		DivisionModifier.Reset();
+		Value.Reset();
+		ClampMin.Reset();
+		ClampMax.Reset();
+		DynamicClampIndices.Reset();
+	}
+
+	// Recompute ((Base + Additive) * Multiply) / Division and apply static clamps for every attribute in one batch.
+	void CalculateValues();
+};
+
+/**
+ * Column an attribute is a view over, set by the owning attribute set. Never carried over by copies: a copied
+ * attribute is detached, and holds the numeric state its source mirrored from the columns.
+ */
+struct GMCABILITYSYSTEM_API FGMCAttributeColumnView
+{
+	FGMCAttributeColumns* Columns = nullptr;
+	int32 Index = INDEX_NONE;
+
+	FGMCAttributeColumnView() {}
+	FGMCAttributeColumnView(const FGMCAttributeColumnView&) {}
+	FGMCAttributeColumnView& operator=(const FGMCAttributeColumnView&)
+	{
+		Bind(nullptr, INDEX_NONE);
+		return *this;
+	}
+
+	void Bind(FGMCAttributeColumns* InColumns, int32 InIndex)
+	{
+		Columns = InColumns;
+		Index = InColumns ? InIndex : INDEX_NONE;
+	}
+};
+
 USTRUCT(BlueprintType)
 struct GMCABILITYSYSTEM_API FAttribute : public FFastArraySerializerItem
 {
@@ -32,6 +132,40 @@ struct GMCABILITYSYSTEM_API FAttribute : public FFastArraySerializerItem
 	UPROPERTY()
 	mutable float DivisionModifier{1};
 
+	// Column storage this attribute is a view over. Unbound if the owning set doesn't use column storage.
+	// Copies are memberwise except for this view, which they never keep.
+	FGMCAttributeColumnView ColumnView;
+
+	// Accessors to the authoritative numeric state, which lives either inline or in the owning set's columns.
+	float& BaseValueRef() const { return ColumnView.Columns ? ColumnView.Columns->BaseValue[ColumnView.Index] : BaseValue; }
+	float& ValueRef() const { return ColumnView.Columns ? ColumnView.Columns->Value[ColumnView.Index] : Value; }
+	float& AdditiveModifierRef() const { return ColumnView.Columns ? ColumnView.Columns->AdditiveModifier[ColumnView.Index] : AdditiveModifier; }
+	float& MultiplyModifierRef() const { return ColumnView.Columns ? ColumnView.Columns->MultiplyModifier[ColumnView.Index] : MultiplyModifier; }
+	float& DivisionModifierRef() const { return ColumnView.Columns ? ColumnView.Columns->DivisionModifier[ColumnView.Index] : DivisionModifier; }
+
+	float& ChannelRef(EGMCAttributeChannel Channel) const
+	{
+		switch (Channel)
+		{
+		case EGMCAttributeChannel::BaseValue: return BaseValueRef();
+		case EGMCAttributeChannel::AdditiveModifier: return AdditiveModifierRef();
+		case EGMCAttributeChannel::MultiplyModifier: return MultiplyModifierRef();
+		case EGMCAttributeChannel::DivisionModifier: return DivisionModifierRef();
+		default: return ValueRef();
+		}
+	}
+
+	// Refresh the inline fields from the columns, when this attribute is a view.
+	void SyncFromColumns() const
+	{
+		if (!ColumnView.Columns) return;
+		BaseValue = BaseValueRef();
+		AdditiveModifier = AdditiveModifierRef();
+		MultiplyModifier = MultiplyModifierRef();
+		DivisionModifier = DivisionModifierRef();
+		Value = ValueRef();
+	}
+
 	void ApplyModifier(const FGMCAttributeModifier& Modifier, bool bModifyBaseValue) const
 	{
 		switch(Modifier.ModifierType)
@@ -39,19 +173,18 @@ struct GMCABILITYSYSTEM_API FAttribute : public FFastArraySerializerItem
 		case EModifierType::Add:
 			if (bModifyBaseValue)
 			{
-				BaseValue += Modifier.Value;
-				BaseValue = Clamp.ClampValue(BaseValue);
+				SetBaseValue(BaseValueRef() + Modifier.Value);
 			}
 			else
 			{
-				AdditiveModifier += Modifier.Value;
+				AdditiveModifier = AdditiveModifierRef() += Modifier.Value;
 			}
 			break;
 		case EModifierType::Multiply:
-			MultiplyModifier += Modifier.Value;
+			MultiplyModifier = MultiplyModifierRef() += Modifier.Value;
 			break;
 		case EModifierType::Divide:
-			DivisionModifier += Modifier.Value;
+			DivisionModifier = DivisionModifierRef() += Modifier.Value;
 			break;
 		default:
 			break;
@@ -61,39 +194,72 @@ struct GMCABILITYSYSTEM_API FAttribute : public FFastArraySerializerItem
 		
 	}
 
+	// Overwrite a modifier channel, e.g. with the value aggregated from every active modifier.
+	void SetModifier(EModifierType ModifierType, float NewValue) const
+	{
+		switch(ModifierType)
+		{
+		case EModifierType::Add:
+			AdditiveModifier = AdditiveModifierRef() = NewValue;
+			break;
+		case EModifierType::Multiply:
+			MultiplyModifier = MultiplyModifierRef() = NewValue;
+			break;
+		case EModifierType::Divide:
+			DivisionModifier = DivisionModifierRef() = NewValue;
+			break;
+		default:
+			break;
+		}
+	}
+
+	float GetModifier(EModifierType ModifierType) const
+	{
+		switch(ModifierType)
+		{
+		case EModifierType::Multiply:
+			return MultiplyModifierRef();
+		case EModifierType::Divide:
+			return DivisionModifierRef();
+		default:
+			return AdditiveModifierRef();
+		}
+	}
+
 	void CalculateValue(bool bClamp = true) const
 	{
 		// Prevent divide by 0 and negative divisors
-		float LocalDivisionModifier = DivisionModifier;
+		float LocalDivisionModifier = DivisionModifierRef();
 		if (LocalDivisionModifier <= 0){
 			LocalDivisionModifier = 1;
 		}
 
 		// Prevent negative multipliers
-		float LocalMultiplyModifier = MultiplyModifier;
+		float LocalMultiplyModifier = MultiplyModifierRef();
 		if (LocalMultiplyModifier < 0){
 			LocalMultiplyModifier = 0;
 		}
 		
-		Value =((BaseValue + AdditiveModifier) * LocalMultiplyModifier) / LocalDivisionModifier;
+		float NewValue = ((BaseValueRef() + AdditiveModifierRef()) * LocalMultiplyModifier) / LocalDivisionModifier;
 		if (bClamp)
 		{
-			Value = Clamp.ClampValue(Value);
+			NewValue = Clamp.ClampValue(NewValue);
 		}
+		Value = ValueRef() = NewValue;
 	}
 
 	// Reset the modifiers to the base value. May cause jank if there's effects going on.
 	void ResetModifiers() const
 	{
-		MultiplyModifier = 1;
-		DivisionModifier = 1;
+		MultiplyModifier = MultiplyModifierRef() = 1;
+		DivisionModifier = DivisionModifierRef() = 1;
 	}
 
 	// Allow for externally directly setting the BaseValue
 	// Usually preferred to go through Effects/Modifiers instead of this
 	void SetBaseValue(const float NewValue) const
 	{
-		BaseValue = Clamp.ClampValue(NewValue);
+		BaseValue = BaseValueRef() = Clamp.ClampValue(NewValue);
 	}
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GMCAbilitySystem")
@@ -106,22 +272,12 @@ struct GMCABILITYSYSTEM_API FAttribute : public FFastArraySerializerItem
 	UPROPERTY(EditDefaultsOnly, Category="Attribute", meta = (Categories="Attribute"))
 	FGameplayTag Tag{FGameplayTag::EmptyTag};
 
-	// Attribute tag which should be used as a base for the regeneration mechanic. Leave it empty for no regen.
-	UPROPERTY(EditDefaultsOnly, Category = "Attribute", meta = (Categories = "Attribute"))
-	FGameplayTag RegenAttributeTag{ FGameplayTag::EmptyTag };
-
-	/**
-	* List of all active tags which block the regeneration of this attribute.
-	* If any of these tags is in the ability system's active tags, the regeneration will not tick.
-	*/
-	UPROPERTY(EditDefaultsOnly, Category = "Attribute", meta = (Categories = "State|Effect"))
-	FGameplayTagContainer RegenBlockingTags;
-
 	// Whether this should be bound over GMC or not.
 	// NOTE: If you don't bind it, you can't use it for any kind of prediction.
 	UPROPERTY(EditDefaultsOnly, Category = "GMCAbilitySystem")
 	bool bIsGMCBound = false;
 
+
 	// Clamp the attribute to a certain range
 	// Clamping will only happen if this is modified
 	UPROPERTY(EditDefaultsOnly, Category = "GMCAbilitySystem")
@@ -135,12 +291,14 @@ struct GMCABILITYSYSTEM_API FAttribute : public FFastArraySerializerItem
 	UGMC_AbilitySystemComponent* AbilitySystem = nullptr;
 
 	/**
-	 * Container of all attributes which are clamped (min and/or max) by this attribute.
+	 * Value received with the previous replication of this item, used by clients to report the old value of a change.
+	 * Not replicated, only meaningful for unbound attributes.
 	 */
-	FGameplayTagContainer AttributesClampedBySelf = FGameplayTagContainer();
+	float LastReplicatedValue{0};
 
 	void PostReplicatedAdd(const FGMCUnboundAttributeSet& InArraySerializer);
 	void PostReplicatedChange(const struct FGMCUnboundAttributeSet& InArraySerializer);
+	void PreReplicatedRemove(const struct FGMCUnboundAttributeSet& InArraySerializer);
 
 	FString ToString() const{
 		return FString::Printf(TEXT("%s : %f (Bound: %d)"), *Tag.ToString(), Value, bIsGMCBound);
@@ -148,7 +306,7 @@ struct GMCABILITYSYSTEM_API FAttribute : public FFastArraySerializerItem
 
 	bool operator < (const FAttribute& Other) const
 	{
-		return Tag.ToString() < Other.Tag.ToString();
+		return FGMCAttributeLayout::IsBoundBefore(Tag, Other.Tag);
 	}
 };
 
@@ -156,21 +314,61 @@ USTRUCT(BlueprintType)
 struct GMCABILITYSYSTEM_API FGMCAttributeSet{
 	GENERATED_BODY()
 
+	FGMCAttributeSet() {}
+	FGMCAttributeSet(const FGMCAttributeSet& Other) : Attributes(Other.Attributes), Columns(Other.Columns) { BindColumnViews(); }
+
+	FGMCAttributeSet& operator=(const FGMCAttributeSet& Other)
+	{
+		Attributes = Other.Attributes;
+		Columns = Other.Columns;
+		BindColumnViews();
+		return *this;
+	}
+
 	UPROPERTY()
 	TArray<FAttribute> Attributes;
 
+	// Optional structure-of-arrays backing of the numeric state. Empty if column storage isn't used.
+	FGMCAttributeColumns Columns;
+
 	void AddAttribute(const FAttribute& NewAttribute)
 	{
-		Attributes.Add(NewAttribute);
-		Attributes.Sort();
+		// The layout changes, so the column storage (if any) has to be rebuilt by the owner.
+		DisableColumnStorage();
+
+		// Attributes are kept in binding order, insert after any attribute that doesn't bind after this one.
+		Attributes.Insert(NewAttribute, Algo::UpperBound(Attributes, NewAttribute));
 	}
 
+	bool UsesColumnStorage() const { return Columns.Num() > 0 && Columns.Num() == Attributes.Num(); }
+
+	/**
+	 * Move the numeric state of every attribute into column storage, turning the attributes into views.
+	 * Must be done before binding, as the columns are never reallocated afterwards.
+	 */
+	void EnableColumnStorage();
+
+	// Move the numeric state back inline and release the columns.
+	void DisableColumnStorage();
+
+	// Recompute every value in one batched pass over the columns, then refresh the attribute views.
+	void CalculateValues();
+
+	// Copies are detached from the columns, their numbers are read from the columns first.
 	TArray<FAttribute> GetAttributes() const
 	{
+		for (const FAttribute& Attribute : Attributes)
+		{
+			Attribute.SyncFromColumns();
+		}
 		return Attributes;
 	}
 
 	void MarkAttributeDirty(const FAttribute& Attribute) {};
+
+private:
+	// Point every attribute at its column, or detach them all if column storage isn't used.
+	void BindColumnViews();
 };
 
 USTRUCT(BlueprintType)
@@ -192,6 +390,14 @@ struct FGMCUnboundAttributeSet : public FFastArraySerializer
 		return Items;
 	}
 
+	void MarkAttributeDirty(int32 Index)
+	{
+		if (Items.IsValidIndex(Index))
+		{
+			MarkItemDirty(Items[Index]);
+		}
+	}
+
 	void MarkAttributeDirty(const FAttribute& Attribute)
 	{
 		for (auto& Item : Items)
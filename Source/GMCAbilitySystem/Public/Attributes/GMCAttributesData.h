@@ -6,6 +6,8 @@
 #include "GameplayTagContainer.h"
 #include "Engine/DataAsset.h"
 #include "Attributes/GMCAttributeClamp.h"
+#include "Attributes/GMCAttributeQuantization.h"
+#include "Attributes/GMCAttributeModifier.h"
 #include "GMCAttributesData.generated.h"
 
 /** Used only in the AttributesData Data Asset to instantiate attributes. */
@@ -18,6 +20,8 @@ struct FAttributeData{
 	FGameplayTag AttributeTag;
 
 	// Attribute tag which should be used as a base for the regeneration mechanic. Leave it empty for no regen.
+	// The value of that attribute is added to the base value of this one every second. Only bound attributes regenerate,
+	// from a bound rate attribute, and they are never quantized.
 	UPROPERTY(EditDefaultsOnly, Category = "Attribute", meta = (Categories = "Attribute"))
 	FGameplayTag RegenAttributeTag{ FGameplayTag::EmptyTag };
 
@@ -38,6 +42,18 @@ struct FAttributeData{
 	 * prediction. */
 	UPROPERTY(EditDefaultsOnly, Category = "GMCAbilitySystem")
 	bool bGMCBound = true;
+
+	/**
+	 * Modifier channels used by duration effects on this attribute. Only these are bound to the GMC along with the base
+	 * value and the value, so leave out the ones this attribute never receives to make moves smaller.
+	 * Instant and periodic effects modify the base value and don't need any channel.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "GMCAbilitySystem", meta = (EditCondition = "bGMCBound", Bitmask, BitmaskEnum = "/Script/GMCAbilitySystem.EGMCAttributeModifierChannel"))
+	uint8 ModifierChannels = static_cast<uint8>(EGMCAttributeModifierChannel::All);
+
+	/** Precision of the attribute in the GMC move history. Lower precisions make moves smaller. */
+	UPROPERTY(EditDefaultsOnly, Category = "GMCAbilitySystem", meta = (EditCondition = "bGMCBound"))
+	FGMCAttributeQuantization Quantization;
 };
 
 /**
@@ -50,4 +66,8 @@ class GMCABILITYSYSTEM_API UGMCAttributesData : public UPrimaryDataAsset{
 public:
 	UPROPERTY(EditDefaultsOnly, Category="AttributeData")
 	TArray<FAttributeData> AttributeData;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
 };
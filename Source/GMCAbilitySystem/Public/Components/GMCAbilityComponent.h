@@ -5,13 +5,20 @@
 #include "CoreMinimal.h"
 #include "GameplayTasksComponent.h"
 #include "Attributes/GMCAttributes.h"
+#include "Attributes/GMCAttributeLayout.h"
+#include "Attributes/GMCAttributeHistory.h"
+#include "Attributes/GMCAttributeModifierAggregator.h"
 #include "GMCMovementUtilityComponent.h"
 #include "Ability/GMCAbilityData.h"
 #include "Ability/GMCAbilityMapData.h"
 #include "Ability/Tasks/GMCAbilityTaskData.h"
 #include "Effects/GMCAbilityEffect.h"
+#include "Effects/GMCLightweightEffect.h"
+#include "Effects/GMCEffectScheduler.h"
+#include "Effects/GMCProcessedEffectIDs.h"
 #include "Components/ActorComponent.h"
 #include "GMCAbilityOuterApplication.h"
+#include "Net/Serialization/FastArraySerializer.h"
 #include "GMCAbilityComponent.generated.h"
 
 
@@ -22,6 +29,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnPreAttributeChanged, UGMCAttribu
                                              SourceAbilityComponent);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnAttributeChanged, FGameplayTag, AttributeTag, float, OldValue, float, NewValue);
 DECLARE_MULTICAST_DELEGATE_ThreeParams(FGameplayAttributeChangedNative, const FGameplayTag&, const float, const float);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FGameplayPreAttributeChangedNative, FGMCAttributeModifier&, UGMC_AbilitySystemComponent*);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnAttributeValueChanged, float, NewValue);
 				
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnAncillaryTick, float, DeltaTime);
@@ -31,8 +39,10 @@ DECLARE_MULTICAST_DELEGATE_TwoParams(FGameplayTagFilteredMulticastDelegate, cons
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnAbilityTriedActivation, FGameplayTag, AbilityTag, bool, bSuccess);
 
+class UGMC_AbilitySystemComponent;
+
 USTRUCT()
-struct FActiveEffectsData
+struct FActiveEffectsData : public FFastArraySerializerItem
 {
 	GENERATED_BODY()
 
@@ -42,17 +52,125 @@ struct FActiveEffectsData
 	UPROPERTY()
 	TSubclassOf<UGMCAbilityEffect> Class;
 
+	// The server applied this effect as a lightweight effect, clients must do the same.
+	UPROPERTY()
+	bool bLightweight = false;
+
 	FActiveEffectsData()
 	{
 		Data = FGMCAbilityEffectData();
 		Class = UGMCAbilityEffect::StaticClass();
 	}
 
-	FActiveEffectsData(const FGMCAbilityEffectData& TargetData, TSubclassOf<UGMCAbilityEffect> TargetClass)
+	FActiveEffectsData(const FGMCAbilityEffectData& TargetData, TSubclassOf<UGMCAbilityEffect> TargetClass, bool bInLightweight = false)
 	{
 		Data = TargetData;
 		Class = TargetClass;
+		bLightweight = bInLightweight;
 	}
+
+	void PostReplicatedAdd(const struct FActiveEffectsDataArray& InArraySerializer);
+	void PostReplicatedChange(const struct FActiveEffectsDataArray& InArraySerializer);
+	void PreReplicatedRemove(const struct FActiveEffectsDataArray& InArraySerializer);
+
+	/**
+	 * Sent as the class, the effect ID, the start and end times in tenths of milliseconds and the fields of the effect
+	 * data which differ from the class default object. The client rebuilds the rest from its own class default object.
+	 * Until the class is loaded on the client, the entry is left with no class and the overrides are skipped.
+	 */
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	// Upper bound of the size of the serialized overrides, larger ones are treated as a corrupted stream.
+	static constexpr uint32 MaxOverrideBits = 1 << 16;
+
+private:
+	// Queues this entry's effect ID on the owner so the next ancillary tick reconciles it.
+	void NoteReplicatedEffectChange(const struct FActiveEffectsDataArray& InArraySerializer) const;
+};
+
+template<>
+struct TStructOpsTypeTraits<FActiveEffectsData> : public TStructOpsTypeTraitsBase2<FActiveEffectsData>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
+/**
+ * Effects applied by the server, replicated to the owning client as a fast array: only the added and removed entries
+ * are sent, and the client is notified of each of them instead of comparing the whole array.
+ */
+USTRUCT()
+struct FActiveEffectsDataArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FActiveEffectsData> Items;
+
+	// Component notified of the replicated entries.
+	UPROPERTY(NotReplicated)
+	UGMC_AbilitySystemComponent* Owner = nullptr;
+
+	void Add(const FActiveEffectsData& EffectData)
+	{
+		MarkItemDirty(Items.Add_GetRef(EffectData));
+	}
+
+	void Remove(int EffectID)
+	{
+		if (Items.RemoveAll([EffectID](const FActiveEffectsData& EffectData) { return EffectData.Data.EffectID == EffectID; }) > 0)
+		{
+			MarkArrayDirty();
+		}
+	}
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FActiveEffectsData, FActiveEffectsDataArray>(Items, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FActiveEffectsDataArray> : public TStructOpsTypeTraitsBase2<FActiveEffectsDataArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+// Ended effects of a class, waiting to be reused.
+USTRUCT()
+struct FGMCAbilityEffectPoolBucket
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<UGMCAbilityEffect>> Effects;
+};
+
+USTRUCT(BlueprintType)
+struct FGMCAbilityEffectPoolStats
+{
+	GENERATED_BODY()
+
+	// Effects taken from the pool.
+	UPROPERTY(BlueprintReadOnly, Category = "GMCAbilitySystem")
+	int32 Hits = 0;
+
+	// Effects created because the pool of their class was empty.
+	UPROPERTY(BlueprintReadOnly, Category = "GMCAbilitySystem")
+	int32 Misses = 0;
+
+	// Ended effects put back in the pool.
+	UPROPERTY(BlueprintReadOnly, Category = "GMCAbilitySystem")
+	int32 Released = 0;
+
+	// Ended effects left to the garbage collector because the pool of their class was full.
+	UPROPERTY(BlueprintReadOnly, Category = "GMCAbilitySystem")
+	int32 Discarded = 0;
 };
 
 USTRUCT()
@@ -102,7 +220,29 @@ public:
 	FGameplayTagContainer GetActiveTags() const { return ActiveTags; }
 
 	// Return the active ability effects
-	TMap<int, UGMCAbilityEffect*> GetActiveEffects() const { return ActiveEffects; }
+	const TMap<int, UGMCAbilityEffect*>& GetActiveEffects() const { return ActiveEffects; }
+
+	// Blueprint version of GetActiveEffects, which copies the map. Native code should use GetActiveEffects.
+	UFUNCTION(BlueprintPure, DisplayName="Get Active Effects", Category="GMAS|Effects")
+	TMap<int, UGMCAbilityEffect*> K2_GetActiveEffects() const { return ActiveEffects; }
+
+	// Return the active effects applied from lightweight effect classes, which aren't part of GetActiveEffects
+	TConstArrayView<FGMCLightweightEffect> GetLightweightEffects() const { return LightweightEffects; }
+
+	// End every started effect with this effect tag, except the given one. Called when an effect starts.
+	void EndStartedEffectsWithTag(const FGameplayTag& EffectTag, int32 ExceptEffectID);
+
+	// Whether a started effect other than the given one stacks on this attribute.
+	bool HasStartedEffectWithStackAttribute(const FGameplayTag& StackAttributeTag, int32 ExceptEffectID) const;
+
+	// Hold the tags granted by a starting effect, until RemoveEffectGrantedTags is called by the effect when it ends.
+	void AddEffectGrantedTags(const FGameplayTagContainer& GrantedTags);
+
+	// Release the tags granted by an ending effect. Tags are removed once nothing holds them anymore.
+	void RemoveEffectGrantedTags(const FGameplayTagContainer& GrantedTags);
+
+	// Called by active effects when their state changes, to keep the started effect indices up to date.
+	void NotifyEffectStateChanged(int32 EffectID, const FGMCAbilityEffectData& EffectData, EGMASEffectState OldState, EGMASEffectState NewState);
 
 	// Return active Effect with tag
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category="GMAS|Abilities")
@@ -135,14 +275,23 @@ public:
 	UFUNCTION(BlueprintPure, meta=(Categories="Ability"), Category = "GMCAbilitySystem")
 	bool HasGrantedAbilityTag(const FGameplayTag GameplayTag) const;
 
-	// Add an ability to the GrantedAbilities array
+	/**
+	 * Add a tag to the active tags. Active tags are reference counted: the tag stays active as long as an effect
+	 * granting it is started or it's matched by MatchTagToBool, even once removed with RemoveActiveTag.
+	 * Adding a tag which was already added this way does nothing, a single RemoveActiveTag releases it.
+	 */
 	UFUNCTION(BlueprintCallable, Category = "GMCAbilitySystem")
 	void AddActiveTag(const FGameplayTag AbilityTag);
 
-	// Remove an ability from the GrantedAbilities array
+	// Release a tag added with AddActiveTag. The tag is removed if nothing else holds it.
 	UFUNCTION(BlueprintCallable, Category = "GMCAbilitySystem")
 	void RemoveActiveTag(const FGameplayTag AbilityTag);
 
+	// Number of holders of an active tag: started effects granting it, AddActiveTag and MatchTagToBool.
+	// Simulated proxies don't know the holders of their tags, their counts are always 0.
+	UFUNCTION(BlueprintPure, Category = "GMCAbilitySystem")
+	int32 GetActiveTagCount(const FGameplayTag GameplayTag) const;
+
 	// Checks whether any active tag matches this tag or any of its children.
 	UFUNCTION(BlueprintPure, Category = "GMCAbilitySystem")
 	bool HasActiveTag(const FGameplayTag GameplayTag) const;
@@ -242,23 +391,33 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "GMCAbilitySystem")
 	FGMCAttributeSet BoundAttributes;
 
-	/** Reminder to check attributes */
-	UPROPERTY()
-	FGMCAttributeSet OldBoundAttributes;
+	/**
+	 * Store the numeric state of bound attributes in contiguous columns (structure of arrays) rather than in each
+	 * attribute. Values are then recomputed in a single batched pass every prediction/simulation tick.
+	 * Worth enabling for pawns with a lot of bound attributes.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "GMCAbilitySystem")
+	bool bUseAttributeColumnStorage = false;
+
+	/**
+	 * Record attribute values and active tags every prediction tick, so that they can be sampled at a past ActionTimer
+	 * (e.g. to validate a hit against the state the client saw when firing). The history is allocated once.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "GMCAbilitySystem")
+	bool bRecordAttributeHistory = false;
+
+	/** Number of prediction ticks kept in the attribute history. */
+	UPROPERTY(EditDefaultsOnly, Category = "GMCAbilitySystem", meta = (EditCondition = "bRecordAttributeHistory", ClampMin = "2"))
+	int32 AttributeHistoryCapacity = 128;
 
 	/** Struct containing attributes that are replicated and unbound from the GMC */
 	UPROPERTY(Replicated, BlueprintReadOnly, Category = "GMCAbilitySystem")
 	FGMCUnboundAttributeSet UnBoundAttributes;
 
-	UPROPERTY()
-	FGMCUnboundAttributeSet OldUnBoundAttributes;
-	
-	UFUNCTION()
-	void OnRep_UnBoundAttributes();
-
 	/**
 	* Function which can be overriden to prevent an effect from being applied.
 	* Override this function if you have gameplay logic which should prevent some effects from being applied.
+	* Lightweight effects pass the default object of their class.
 	*/
 	virtual bool CanApplyAbilityEffect(UGMCAbilityEffect* Effect) { return true; };
 
@@ -270,16 +429,50 @@ public:
 	 * @param	SourceAbilityComponent	Ability Component from which this effect originated
 	 * @param	bOverwriteExistingModifiers	Whether or not to replace existing modifiers that have the same name as additional modifiers. If false, will add them.
 	 * @param	bAppliedByServer	Is this Effect only applied by server? Used to help client predict the unpredictable.
+	 * @return	The applied effect, null if it was applied as a lightweight effect (see ApplyAbilityEffectByID).
 	 */
 	UFUNCTION(BlueprintCallable, Category="GMAS|Effects", meta = (AutoCreateRefTerm = "AdditionalModifiers"))
 	UGMCAbilityEffect* ApplyAbilityEffect(TSubclassOf<UGMCAbilityEffect> Effect, FGMCAbilityEffectData InitializationData, bool bOuterActivation = false);
 	
 	UGMCAbilityEffect* ApplyAbilityEffect(UGMCAbilityEffect* Effect, FGMCAbilityEffectData InitializationData);
+
+	/**
+	 * Apply an effect like ApplyAbilityEffect, but return the ID of the applied effect (0 if it wasn't applied) instead
+	 * of the effect object. Lightweight effects have an ID but no object, end them with RemoveActiveAbilityEffectByID.
+	 */
+	UFUNCTION(BlueprintCallable, Category="GMAS|Effects")
+	int ApplyAbilityEffectByID(TSubclassOf<UGMCAbilityEffect> Effect, FGMCAbilityEffectData InitializationData);
 	
 	
+	/**
+	 * End an active effect. Pooled effects are reused under a new ID once ended: a pointer kept past the end of its effect
+	 * may end whichever effect reuses it. Keep the effect ID and use RemoveActiveAbilityEffectByID instead.
+	 */
 	UFUNCTION(BlueprintCallable, Category="GMAS|Effects")
 	void RemoveActiveAbilityEffect(UGMCAbilityEffect* Effect);
 
+	// End the active effect with this ID, if it's still running. Works with lightweight effects as well.
+	UFUNCTION(BlueprintCallable, Category="GMAS|Effects")
+	void RemoveActiveAbilityEffectByID(int EffectID);
+
+	/**
+	 * Number of ended effects kept per effect class, to be reused by later applications instead of duplicating the
+	 * class default object every time. 0 disables pooling.
+	 * Ended effects are recycled as soon as they leave the active effects, don't keep pointers to them past their end.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "GMCAbilitySystem", meta = (ClampMin = "0"))
+	int32 EffectPoolCapacityPerClass = 0;
+
+	/** Get a fresh instance of an effect class, taken from the pool if possible. The effect isn't applied. */
+	UGMCAbilityEffect* AcquireEffect(TSubclassOf<UGMCAbilityEffect> EffectClass);
+
+	UFUNCTION(BlueprintPure, Category="GMAS|Effects")
+	FGMCAbilityEffectPoolStats GetEffectPoolStats() const { return EffectPoolStats; }
+
+	// Number of effect IDs this client currently remembers having processed. Also summed over components in "stat game".
+	UFUNCTION(BlueprintPure, Category="GMAS|Effects")
+	int32 GetNumProcessedEffectIDs() const { return ProcessedEffectIDs.Num(); }
+
 	/**
 	 * Removes an instanced effect if it exists. If NumToRemove == -1, remove all. Returns the number of removed instances.
 	 * If the inputted count is higher than the number of active corresponding effects, remove all we can.
@@ -319,7 +512,7 @@ public:
 	/**
 	* Used exclusively by the FAttributes structure to broadcast a change after client replication.
 	*/
-	void BroadcastAttributeChangeBySerializedItem(FGameplayTag AttributeTag, float NewValue);
+	void BroadcastAttributeChangeBySerializedItem(FGameplayTag AttributeTag, float OldValue, float NewValue);
 
 	// Called during the Ancillary Tick
 	UPROPERTY(BlueprintAssignable)
@@ -338,6 +531,41 @@ public:
 	/** Get an Attribute using its Tag */
 	const FAttribute* GetAttributeByTag(FGameplayTag AttributeTag) const;
 
+	/**
+	 * Resolve an attribute tag into a handle. Hot callers should resolve once and then go through
+	 * GetAttributeByHandle/GetAttributeValueByHandle, which don't need any tag lookup.
+	 * Returns an invalid handle if no attribute matches the tag.
+	 */
+	UFUNCTION(BlueprintPure, Category="GMAS|Attributes")
+	FGMCAttributeHandle GetAttributeHandle(UPARAM(meta=(Categories="Attribute"))FGameplayTag AttributeTag) const;
+
+	/** Get an Attribute using a previously resolved handle */
+	const FAttribute* GetAttributeByHandle(const FGMCAttributeHandle& Handle) const;
+
+	// Get Attribute value by Handle
+	UFUNCTION(BlueprintPure, Category="GMAS|Attributes")
+	float GetAttributeValueByHandle(const FGMCAttributeHandle& Handle) const;
+
+	/** Flag the attribute lookup as outdated, it will be rebuilt on next access. Called when unbound attributes replicate. */
+	void MarkAttributeLookupDirty() { bAttributeLookupDirty = true; }
+
+	/** Static description of the attributes of this component. Null until attributes have been instantiated. */
+	const FGMCAttributeLayout* GetAttributeLayout() const { return AttributeLayout.Get(); }
+
+	/**
+	 * Get the value an attribute had at a past ActionTimer, interpolated between recorded prediction ticks.
+	 * Requires bRecordAttributeHistory. Returns the current value if the time isn't covered by the history.
+	 */
+	UFUNCTION(BlueprintPure, Category="GMAS|Attributes")
+	float GetAttributeValueAtTime(const FGMCAttributeHandle& Handle, double Time) const;
+
+	/**
+	 * Whether a tag (or one of its children) was active at a past ActionTimer.
+	 * Requires bRecordAttributeHistory. Returns whether the tag is currently active if the time isn't covered by the history.
+	 */
+	UFUNCTION(BlueprintPure, Category="GMAS|Attributes")
+	bool HadActiveTagAtTime(FGameplayTag GameplayTag, double Time) const;
+
 	// Get Attribute value by Tag
 	UFUNCTION(BlueprintPure, Category="GMAS|Attributes")
 	float GetAttributeValueByTag(UPARAM(meta=(Categories="Attribute"))FGameplayTag AttributeTag) const;
@@ -355,11 +583,43 @@ public:
 	/** Get the default value of an attribute from the data assets. */
 	UFUNCTION(BlueprintCallable, Category="GMAS|Attributes")
 	float GetBaseAttributeValueByTag(UPARAM(meta=(Categories="Attribute"))FGameplayTag AttributeTag) const;
+
+	/** Get the default value of an attribute from a previously resolved handle. Returns -1 if the handle is invalid. */
+	UFUNCTION(BlueprintPure, Category="GMAS|Attributes")
+	float GetBaseAttributeValueByHandle(const FGMCAttributeHandle& Handle) const;
+
+	/**
+	 * Get the default values of several attributes at once, e.g. to refresh a whole UI.
+	 * OutValues must be as large as Handles, invalid handles get -1.
+	 */
+	void GetBaseAttributeValues(TConstArrayView<FGMCAttributeHandle> Handles, TArrayView<float> OutValues) const;
 	
 	// Apply modifiers that affect attributes
 	UFUNCTION(BlueprintCallable, Category="GMAS|Attributes")
 	void ApplyAbilityEffectModifier(FGMCAttributeModifier AttributeModifier,bool bModifyBaseValue, bool bNegateValue = false, UGMC_AbilitySystemComponent* SourceAbilityComponent = nullptr);
 
+	/**
+	 * Apply several modifiers at once. Clamps are resolved once after the whole batch has been applied, and each
+	 * touched attribute broadcasts a single change (from its value before the batch to its final value).
+	 * With NumApplications above one (e.g. several period ticks caught up at once), a single modifier is scaled by it
+	 * in one batch, pre-change listeners seeing it once with their changes scaled as well. Several modifiers are
+	 * applied in that many batches instead, as clamps in between would make the scaled result differ.
+	 */
+	void ApplyAbilityEffectModifiers(TConstArrayView<FGMCAttributeModifier> AttributeModifiers, bool bModifyBaseValue, bool bNegateValue = false, UGMC_AbilitySystemComponent* SourceAbilityComponent = nullptr, int32 NumApplications = 1);
+
+	/**
+	 * Add the duration modifiers of an effect to the modifier channels of their attributes, under the effect ID.
+	 * They stay until RemoveEffectModifiers is called with the same ID, which removes exactly what was added.
+	 */
+	void AddEffectModifiers(int32 EffectID, TConstArrayView<FGMCAttributeModifier> AttributeModifiers, UGMC_AbilitySystemComponent* SourceAbilityComponent = nullptr);
+
+	// Remove every modifier added by an effect through AddEffectModifiers.
+	void RemoveEffectModifiers(int32 EffectID);
+
+	/** Get every modifier currently contributing to an attribute, along with the effect it comes from. */
+	UFUNCTION(BlueprintCallable, Category="GMAS|Attributes")
+	TArray<FGMCAttributeModifierContribution> GetAttributeModifierBreakdown(const FGMCAttributeHandle& Handle) const;
+
 	virtual void OnAttributeMaxClampChanged(const FGameplayTag& ClampedAttribute, const FGameplayTag& MaxAttribute, float OldMaxValue, float NewMaxValue) {};
 
 	UPROPERTY(BlueprintReadWrite, Category = "GMCAbilitySystem")
@@ -403,6 +663,20 @@ public:
 	 */
 	void RemoveAttributeChangeDelegate(FDelegateHandle Handle);
 
+	/**
+	 * Adds a native delegate called before an attribute modifier is applied. The modifier is passed by reference
+	 * and can be altered in place. Native handlers run before the Blueprint OnPreAttributeChanged event.
+	 * @param Delegate The delegate to call before attribute changes.
+	 * @return A handle to use when removing this delegate.
+	 */
+	FDelegateHandle AddPreAttributeChangeDelegate(const FGameplayPreAttributeChangedNative::FDelegate& Delegate);
+
+	/**
+	 * Removes a native delegate for pre attribute changes.
+	 * @param Handle The delegate handle to be removed.
+	 */
+	void RemovePreAttributeChangeDelegate(FDelegateHandle Handle);
+
 #pragma region GMC
 	// GMC
 	UFUNCTION(BlueprintCallable, Category="GMAS")
@@ -487,6 +761,8 @@ protected:
 
 	FGameplayAttributeChangedNative NativeAttributeChangeDelegate;
 
+	FGameplayPreAttributeChangedNative NativePreAttributeChangeDelegate;
+
 	void AddAbilityMapData(const FAbilityMapData& AbilityMapData);
 
 private:
@@ -530,15 +806,135 @@ private:
 	// This must run before variable binding
 	void InstantiateAttributes();
 
+	// Static description of our attributes, shared with every component using the same data assets.
+	TSharedPtr<const FGMCAttributeLayout> AttributeLayout;
+
+	// Incremented every time attributes are instantiated, so that stale handles can be detected.
+	uint32 AttributeLayoutSerial = 0;
+
+	// Index in UnBoundAttributes.Items of every unbound slot of the layout, as clients receive items in any order.
+	mutable TArray<int32> UnboundItemIndices;
+
+	mutable bool bAttributeLookupDirty = false;
+
+	// Rebuild the unbound slot remapping from the current unbound set.
+	void RebuildAttributeLookup() const;
+
+	// Node of an attribute, which is its slot in the attribute layout (and in the clamp graph).
+	int32 GetAttributeNode(const FGMCAttributeHandle& Handle) const;
+	const FAttribute* GetAttributeByNode(int32 Node) const;
+	int32 GetUnboundItemIndex(int32 Node) const;
+
+	// Attribute modified during a modifier application, by clamp graph node, with its value before the application.
+	struct FPendingAttributeChange
+	{
+		int32 Node;
+		float OldValue;
+	};
+	using FAttributeChangeBatch = TArray<FPendingAttributeChange, TInlineAllocator<16>>;
+
+	// Add an attribute to the batch with its current value, unless it's already part of it.
+	static void AddPendingAttributeChange(FAttributeChangeBatch& Batch, int32 Node, float OldValue);
+
+	// Modifier channels of every attribute, as the sum of the modifiers contributing to them. Local state, not rolled
+	// back: modifiers without an effect on channels bound to the GMC are summed in RolledBackUnownedModifiers instead.
+	FGMCAttributeModifierAggregator ModifierAggregator;
+
+	// Sums of the modifiers without an effect of the modifier channels bound to the GMC, per bound attribute and channel.
+	// Bound to the GMC, so this array must never be reallocated after binding.
+	TArray<float> RolledBackUnownedModifiers;
+
+	// Overwrite a modifier channel of an attribute with its identity, its modifiers without an effect and its effects.
+	void SyncModifierChannel(const FAttribute& Attribute, int32 Node, EModifierType ModifierType);
+
+	// Whether a modifier channel of an attribute is bound to the GMC, and so restored on corrections.
+	bool IsModifierChannelRolledBack(int32 Node, EModifierType ModifierType) const;
+
+	// Sum of the modifiers without an effect of a channel rolled back by the GMC, null for other channels.
+	float* FindRolledBackUnownedModifier(int32 Node, EModifierType ModifierType);
+	const float* FindRolledBackUnownedModifier(int32 Node, EModifierType ModifierType) const;
+
+	// Re-clamp every attribute clamped, directly or not, by an attribute of the batch. Single ordered pass.
+	// Re-clamped attributes are added to the batch.
+	void ResolveAttributeClamps(FAttributeChangeBatch& Batch);
+
+	// Broadcast a single change for every attribute of the batch whose value changed, and flag them for replication.
+	void CommitAttributeChanges(const FAttributeChangeBatch& Batch);
+
+	// Compact representation of the quantized bound attributes, laid out by the attribute layout. These words are bound
+	// to the GMC instead of the attribute floats, so this array must never be reallocated after binding.
+	TArray<int32> QuantizedAttributeWords;
+
+	// Warn about modifiers of an effect going into a modifier channel that isn't bound to the GMC.
+	void ValidateEffectModifierChannels(const FGMCAbilityEffectData& EffectData);
+
+	// Attribute and channel pairs already reported by ValidateEffectModifierChannels, to avoid flooding the log.
+	TSet<TPair<FGameplayTag, EGMCAttributeModifierChannel>> ReportedUnboundModifierChannels;
+
+	// Write the quantized bound attributes into their words. Done whenever the attributes may have changed, so that the
+	// GMC records their latest state.
+	void EncodeQuantizedAttributes();
+
+	// Read the quantized bound attributes back from their words, which the GMC may have rewritten (replay, correction).
+	void DecodeQuantizedAttributes();
+
+	// Give native handlers and Blueprint listeners a chance to alter a modifier before it's applied.
+	void BroadcastPreAttributeChange(FGMCAttributeModifier& AttributeModifier, UGMC_AbilitySystemComponent* SourceAbilityComponent);
+
+	// Container handed to OnPreAttributeChanged listeners, reused across modifier applications.
+	UPROPERTY()
+	TObjectPtr<UGMCAttributeModifierContainer> PreAttributeChangeContainer;
+
+	// Set while PreAttributeChangeContainer is being broadcast, in case a listener applies another modifier.
+	bool bPreAttributeChangeContainerInUse = false;
+
+	// Call every attribute changed delegate for an attribute.
+	void BroadcastAttributeChange(const FAttribute& Attribute, float OldValue);
+
+	// Flag a modified attribute for replication and for CheckAttributeChanged, by clamp graph node.
+	// Unbound attributes only dirty their own item.
+	void MarkAttributeDirty(int32 Node);
+
 	void SetStartingTags();
 
+	// Number of started effects granting each tag. Local state, effects aren't rolled back.
+	TMap<FGameplayTag, int32> EffectGrantedTagCounts;
+
+	// Tags held through AddActiveTag and through MatchTagToBool, each of them holding a tag once at most.
+	// Bound to the GMC, so that corrections restore them along with ActiveTags.
+	FGameplayTagContainer AddedActiveTags;
+	FGameplayTagContainer MatchedActiveTags;
+
+	// A tag is in ActiveTags exactly when something holds it.
+	bool IsActiveTagHeld(const FGameplayTag& Tag) const;
+
+	// Rebuild ActiveTags from its holders after the GMC rewrote it (correction, replay). The bound holders were restored
+	// along with it; tags granted by local effects are added back, the ones only the server's effects grant are left to
+	// the replication of these effects.
+	void ReconcileActiveTags();
+
 	// Check if ActiveTags has changed and call delegates
 	void CheckActiveTagsChanged();
 
 	// Check if any Attribute has changed and call delegates
 	void CheckAttributeChanged();
 
-	void CheckAttributeChanged_Internal(FGMCAttributeSet& OldAttributeSet, FGMCAttributeSet& NewAttributeSet);
+	// Flag every bound attribute as possibly changed, for when the GMC may have rewritten them.
+	void MarkAllBoundAttributesChanged();
+
+	// Flag the bound attributes whose value differs from the end of the last prediction tick, i.e. the ones the GMC
+	// rewrote in between (replay, correction).
+	void MarkRewrittenBoundAttributesChanged();
+
+	// Value of every bound attribute when CheckAttributeChanged last ran, by slot.
+	TArray<float> PreviousBoundValues;
+
+	// Value of every bound attribute at the end of the last prediction tick, by slot. Only kept up to date on clients.
+	TArray<float> PredictedBoundValues;
+
+	// Bound attributes modified since CheckAttributeChanged last ran, by slot.
+	TBitArray<> ChangedBoundAttributes;
+	bool bAnyBoundAttributeChanged = false;
 	
 	// Clear out abilities in the Ended state from the ActivateAbilities map
 	void CleanupStaleAbilities();
@@ -555,21 +951,41 @@ private:
 	// Tick ability cooldowns
 	void TickActiveCooldowns(float DeltaTime);
 
+	// Regenerate attributes with a regen source. Runs in the prediction tick on bound attributes, so it's replayed
+	// along with them.
+	void TickAttributeRegen(float DeltaTime);
+
+	// Snapshot of every attribute and of the active tags at each prediction tick, if bRecordAttributeHistory is set.
+	FGMCAttributeHistory AttributeHistory;
+
+	// Add the current state to the attribute history.
+	void RecordAttributeHistory();
+
+	// Regens of the layout blocked by the active tags, rebuilt when the active tags differ from RegenBlockingCheckedTags.
+	TBitArray<> BlockedRegens;
+	FGameplayTagContainer RegenBlockingCheckedTags;
+	bool bAnyRegenBlocked = false;
+
 	// Active Effects with a duration affecting this component
 	// Can be just normally replicated since if the client doesn't have them already
 	// then prediction is already out the window
-
-	UPROPERTY(ReplicatedUsing = OnRep_ActiveEffectsData)
-	TArray<FActiveEffectsData> ActiveEffectsData;
+	UPROPERTY(Replicated)
+	FActiveEffectsDataArray ActiveEffectsData;
 
 	// Max time a client will predict an effect without it being confirmed by the server before cancelling
 	float ClientEffectApplicationTimeout = 1.f;
 
-	UFUNCTION()
-	void OnRep_ActiveEffectsData();
+	// Apply an effect the server replicated, or confirm it if it was predicted.
+	void OnActiveEffectDataReplicated(const FActiveEffectsData& ActiveEffectData);
 
-	// Check if any effects have been removed by the server and remove them locally
-	void CheckRemovedEffects();
+	// IDs of the ActiveEffectsData entries replication added or removed since the last reconciliation.
+	TArray<int> ReplicatedEffectChanges;
+
+	// Bring the local effects in line with the entries replication changed: apply or confirm the added ones, remove
+	// the removed ones. Does nothing until replication delivers changes.
+	void ReconcileReplicatedEffects();
+
+	friend struct FActiveEffectsData;
 
 	// Effect applied externally, pending activation, used by server and client. Not replicated.
 	//TODO: Later we will need to encapsulate this with Instanced struct to have a more generic way to handle this, and have cohabitation server <-> client
@@ -600,11 +1016,98 @@ private:
 
 	int LateApplicationIDCounter = 0;
 
-	// Effect IDs that have been processed and don't need to be remade when ActiveEffectsData is replicated
-	// This need to be persisted for a while
-	// This never empties out so it'll infinitely grow, probably a better way to accomplish this
+	// New effect ID, unique among effect objects and lightweight effects.
+	int GenerateEffectID() const;
+
+	bool IsEffectIDInUse(int EffectID) const;
+
+	// True while the effect with this ID is pending or running and hasn't completed.
+	bool IsEffectActive(int EffectID) const;
+
+	// Effects applied from lightweight effect classes, by value. Driven by their timers instead of being ticked.
+	TArray<FGMCLightweightEffect> LightweightEffects;
+
+	// Index of each lightweight effect in LightweightEffects, by effect ID.
+	TMap<int32, int32> LightweightEffectIndices;
+
+	// Start, end, period and confirmation timeout of the lightweight effects.
+	FGMCEffectScheduler LightweightEffectTimers;
+	uint32 LastLightweightEffectTimerSerial = 0;
+
+	// Active tags the last time the tag requirements of the lightweight effects were checked.
+	FGameplayTagContainer LightweightEffectCheckedTags;
+
+	// Start, end, period and confirmation timeout of the effect objects without per-frame logic, which aren't ticked.
+	FGMCEffectScheduler EffectTimers;
+	uint32 LastEffectTimerSerial = 0;
+
+	// Active tags the last time the tag requirements of the effect objects driven by timers were checked.
+	FGameplayTagContainer TimedEffectCheckedTags;
+
+	// Set when an effect ends, so that ended lightweight effects are only looked for when there are some.
+	bool bEffectsEndedSinceCleanup = false;
+
+	// Lightweight effects applied while LightweightEffects was being iterated, added to it when the iteration ends.
+	TArray<FGMCLightweightEffect> PendingLightweightEffects;
+
+	int32 LightweightEffectScopeDepth = 0;
+
+	// Held while calling into lightweight effects, which may apply other effects, so that LightweightEffects doesn't
+	// reallocate under them. The outermost scope adds the pending lightweight effects.
+	struct FLightweightEffectScope
+	{
+		explicit FLightweightEffectScope(UGMC_AbilitySystemComponent& InComponent);
+		~FLightweightEffectScope();
+
+		UGMC_AbilitySystemComponent& Component;
+	};
+
+	// Apply an effect without instantiating it. InitializationData only provides the ID and the times, if set.
+	// Returns the ID of the effect, 0 if it wasn't applied.
+	int ApplyLightweightEffect(const TSharedRef<const FGMCLightweightEffectSpec>& Spec, const FGMCAbilityEffectData& InitializationData);
+
+	void FlushPendingLightweightEffects();
+
+	// Schedule the timers of an effect which was just added to LightweightEffects, starting it if it's due.
+	void ScheduleLightweightEffect(FGMCLightweightEffect& Effect);
+
+	// Schedule the end and the first period tick of an effect which just started.
+	void ScheduleStartedLightweightEffect(const FGMCLightweightEffect& Effect);
+
+	// Run the lightweight effect timers which are due, and check the tag requirements if the active tags changed.
+	void TickLightweightEffects();
+
+	// Remove the ended lightweight effects along with their timers, adding their IDs to EndedEffectIDs.
+	void RemoveEndedLightweightEffects(TArray<int>& EndedEffectIDs);
+
+	// Drive an effect object which was just added to ActiveEffects by timers, unless it has per-frame logic.
+	void ScheduleEffect(UGMCAbilityEffect& Effect);
+
+	// Schedule the end and the first period tick of an effect object driven by timers which just started.
+	void ScheduleStartedEffect(const UGMCAbilityEffect& Effect);
+
+	// Run the effect object timers which are due, and check the tag requirements if the active tags changed.
+	void TickTimedEffects();
+
+	// Lightweight effect with this ID, pending or not.
+	FGMCLightweightEffect* FindLightweightEffect(int EffectID);
+
+	// Started effects, objects and lightweight ones, by effect tag and by stack attribute. Updated on effect state
+	// changes, so that starting or ending an effect doesn't need to go through every active effect.
+	TMap<FGameplayTag, TArray<int32, TInlineAllocator<2>>> StartedEffectsByTag;
+	TMap<FGameplayTag, TArray<int32, TInlineAllocator<2>>> StartedEffectsByStackAttribute;
+
+	// Put an effect which left the active effects back in the pool of its class, if there is room.
+	void ReleaseEffect(UGMCAbilityEffect* Effect);
+
 	UPROPERTY()
-	TMap<int /*ID*/, bool /*bServerConfirmed*/> ProcessedEffectIDs;
+	TMap<TSubclassOf<UGMCAbilityEffect>, FGMCAbilityEffectPoolBucket> EffectPool;
+
+	FGMCAbilityEffectPoolStats EffectPoolStats;
+
+	// Effect IDs that have been processed and don't need to be remade when ActiveEffectsData is replicated, on clients.
+	// Forgotten after a while, see FGMCProcessedEffectIDs.
+	FGMCProcessedEffectIDs ProcessedEffectIDs;
 
 	// Let the client know that the server has activated this ability as well
 	// Needed for the client to cancel mis-predicted abilities
@@ -81,7 +81,7 @@ struct FGMCAbilityEffectData
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "GMCAbilitySystem")
 	bool bIsInstant = true;
 
-	// Apply an inversed version of the modifiers at effect end
+	// Remove the modifiers added by this effect at effect end
 	UPROPERTY()
 	bool bNegateEffectAtEnd = false;
 
@@ -225,6 +225,76 @@ struct FGMCAbilityEffectData
 	FString ToString() const{
 		return FString::Printf(TEXT("[id: %d] [Tag: %s] (Duration: %.3lf) (CurrentDuration: %.3lf)"), EffectID, *EffectTag.ToString(), Duration, CurrentDuration);
 	}
+
+	/**
+	 * Number of period ticks due by this ActionTimer for the effect started at EffectStartTime, counting the tick at start
+	 * if any. Times are converted to fixed point first, so that server and clients count the same ticks from the same
+	 * times whatever the float error.
+	 * Effects with a duration only count the periods due by EffectEndTime, a tick due exactly at the end time included.
+	 */
+	int32 GetNumPeriodsDue(double EffectStartTime, double EffectEndTime, double ActionTimer) const
+	{
+		if (Period <= 0) return 0;
+
+		int64 Elapsed = ToPeriodFixedTime(ActionTimer) - ToPeriodFixedTime(EffectStartTime + PeriodInitialDelay);
+		if (Duration != 0)
+		{
+			// Taken from the time difference, so that a duration which is a whole number of periods counts its last tick.
+			Elapsed = FMath::Min(Elapsed, ToPeriodFixedTime(EffectEndTime - EffectStartTime - PeriodInitialDelay));
+		}
+		if (Elapsed < 0) return 0;
+
+		const int64 NumPeriods = Elapsed / FMath::Max<int64>(ToPeriodFixedTime(Period), 1) + (bPeriodTickAtStart ? 1 : 0);
+		return static_cast<int32>(FMath::Min<int64>(NumPeriods, MAX_int32));
+	}
+
+	// ActionTimer at which the period tick of this index (0 being the first one) is due.
+	double GetPeriodTime(double EffectStartTime, int32 PeriodIndex) const
+	{
+		const int64 FirstPeriod = bPeriodTickAtStart ? 0 : 1;
+		const int64 FixedTime = ToPeriodFixedTime(EffectStartTime + PeriodInitialDelay) + (PeriodIndex + FirstPeriod) * FMath::Max<int64>(ToPeriodFixedTime(Period), 1);
+		return FixedTime / PeriodTimeResolution;
+	}
+
+	// Period ticks are counted on tenths of milliseconds.
+	static constexpr double PeriodTimeResolution = 10000.0;
+
+	static int64 ToPeriodFixedTime(double Time) { return FMath::RoundToInt64(Time * PeriodTimeResolution); }
+
+	/**
+	 * Serialize the fields which differ from Defaults, usually the effect data of the class default object: a bitmask
+	 * of the overridden fields followed by their values. When loading, fields which aren't overridden must already
+	 * hold their default value. EffectID, the times and the owner are left to the caller.
+	 */
+	bool NetSerializeOverrides(FArchive& Ar, UPackageMap* Map, const FGMCAbilityEffectData& Defaults);
+
+	// Data-driven steps of the effect lifecycle, shared by effect objects and lightweight effects.
+	// RunningEffectID is the ID of the running effect, which the shared data of lightweight effects doesn't hold.
+
+	// Does the owner have any of the tags from the container?
+	static bool DoesOwnerHaveTagFromContainer(const UGMC_AbilitySystemComponent& Owner, const FGameplayTagContainer& TagContainer);
+
+	// Whether the owner's tags meet MustHaveTags and MustNotHaveTags, required for the effect to keep running.
+	bool OwnerMeetsTagRequirements(const UGMC_AbilitySystemComponent& Owner) const;
+
+	// Whether the owner's tags meet the application requirements, as well as the ones to keep running.
+	bool OwnerMeetsApplicationTagRequirements(const UGMC_AbilitySystemComponent& Owner) const;
+
+	// Instant effects never remove their tags, they're held like any tag added with AddActiveTag.
+	void AddGrantedTagsToOwner(UGMC_AbilitySystemComponent& Owner) const;
+	void RemoveGrantedTagsFromOwner(UGMC_AbilitySystemComponent& Owner) const;
+
+	// Grant the tags and abilities of the effect, remove its removed abilities and end its cancelled ones.
+	void ApplyGrantsToOwner(UGMC_AbilitySystemComponent& Owner) const;
+
+	// Add one stack and the modifiers of a duration effect which isn't periodic, once started.
+	void ApplyDurationModifiersToOwner(UGMC_AbilitySystemComponent& Owner, int32 RunningEffectID) const;
+
+	/**
+	 * Undo what starting the effect did: reset the stacks if no other effect holds one, remove the modifiers if
+	 * bRemoveModifiers, and unless instant, take back the granted tags and abilities and give back the removed ones.
+	 */
+	void RevertFromOwner(UGMC_AbilitySystemComponent& Owner, int32 RunningEffectID, bool bRemoveModifiers) const;
 };
 
 /**
@@ -243,6 +313,18 @@ public:
 	UPROPERTY(EditAnywhere, Category = "GMCAbilitySystem")
 	FGMCAbilityEffectData EffectData;
 
+	/**
+	 * Apply this effect as plain data on the component instead of instantiating it, when it's applied without custom
+	 * initialization data. Only for Blueprint effects which implement none of the effect events.
+	 * Lightweight effects can't be retrieved as effect objects: applying them returns null.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "GMCAbilitySystem")
+	bool bLightweight = false;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 	UFUNCTION(BlueprintCallable, Category = "GMCAbilitySystem")
 	virtual void InitializeEffect(FGMCAbilityEffectData InitializationData);
 	
@@ -253,13 +335,28 @@ public:
 	
 	virtual void Tick(float DeltaTime);
 
+	/**
+	 * Whether effects of this class have logic to run every frame: a TickEvent implemented in Blueprint, or a native
+	 * subclass which may override Tick. Other effects are only run by the component when their start, period and end
+	 * times are due.
+	 */
+	static bool HasPerFrameLogic(const UClass* EffectClass);
+
+	// End the effect if the owner's tags don't meet its MustHaveTags and MustNotHaveTags anymore.
+	void CheckTagRequirements();
+
+	// Apply the period ticks due since the last one (up to the end time), and move the next period time.
+	void TickPeriod();
+
+	double GetNextPeriodTime() const { return NextPeriodTime; }
+
 	// Return the current duration of the effect
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category="GMAS|Abilities")
-	float GetCurrentDuration() const { return EffectData.CurrentDuration; }
+	float GetCurrentDuration() const;
 
 	// Return the current duration of the effect
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category="GMAS|Abilities")
-	FGMCAbilityEffectData GetEffectData() const { return EffectData; }
+	FGMCAbilityEffectData GetEffectData() const;
 
 	// Return the current duration of the effect
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category="GMAS|Abilities")
@@ -273,8 +370,16 @@ public:
 	UFUNCTION(BlueprintNativeEvent, meta=(DisplayName="Dynamic Condition"), Category="GMCAbilitySystem")
 	bool AttributeDynamicCondition() const;
 	
+	// Apply the period modifiers once. Called once per period, even when a long tick catches up on several.
 	virtual void PeriodTick();
 	virtual void PeriodTick_Implementation() {};
+
+	// Put the effect back in the state of its class default object, so that it can be applied again. Used by effect pools.
+	virtual void ResetForReuse();
+
+	// Called when an ended effect has been reset to be reused. Reset any state the class default object doesn't hold.
+	UFUNCTION(BlueprintNativeEvent, meta=(DisplayName="Reset For Reuse"), Category="GMCAbilitySystem")
+	void ResetEvent();
 	
 	void UpdateState(EGMASEffectState State, bool Force=false);
 
@@ -288,6 +393,9 @@ public:
 	// confirmed this effect within a time range, the effect will be cancelled.
 	float ClientEffectApplicationTime;
 
+	// Set by the component while the effect is driven by its effect timers instead of being ticked, 0 otherwise.
+	uint32 TimerSerial = 0;
+
 protected:
 	UPROPERTY()
 	UGMC_AbilitySystemComponent* SourceAbilityComponent;
@@ -318,7 +426,8 @@ protected:
 
 private:
 	// Used for calculating when to tick Period effects
-	float PrevPeriodMod = -1.f;
+	int32 NumPeriodsApplied = 0;
+	double NextPeriodTime = 0;
 
 public:
 	FString ToString() {
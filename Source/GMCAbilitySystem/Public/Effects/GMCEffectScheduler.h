@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Events of an effect scheduled on the ActionTimer, in the order they're processed when due at the same time.
+enum class EGMCEffectTimerType : uint8
+{
+	Start,
+	Period,
+	End,
+	ConfirmationTimeout
+};
+
+struct FGMCEffectTimer
+{
+	double Time = 0;
+	int32 EffectID = 0;
+
+	// Identifies the effect instance the timer was scheduled for, effect IDs being reused once an effect is gone.
+	uint32 Serial = 0;
+
+	EGMCEffectTimerType Type = EGMCEffectTimerType::Start;
+};
+
+/**
+ * Min-heap of effect timers keyed on the ActionTimer, so that effects only cost something when one of their events is due.
+ * Timers due at the same time come out by effect ID then type, which only depend on replicated data: server and clients
+ * process them in the same order whatever order they were scheduled in.
+ * Timers are not cancelled, whoever pops one checks that its effect instance is still around.
+ */
+class GMCABILITYSYSTEM_API FGMCEffectScheduler
+{
+public:
+	void Schedule(double Time, int32 EffectID, uint32 Serial, EGMCEffectTimerType Type);
+
+	// Pop the earliest timer due at this ActionTimer, if any.
+	bool PopDue(double ActionTimer, FGMCEffectTimer& OutTimer);
+
+	// Drop the timers for which the predicate returns true, such as those of effect instances which are gone.
+	template <typename PredicateType>
+	void RemoveAll(PredicateType Predicate)
+	{
+		if (Timers.RemoveAll(Predicate) > 0)
+		{
+			Timers.Heapify(FTimerOrder());
+		}
+	}
+
+	int32 Num() const { return Timers.Num(); }
+	void Reset() { Timers.Reset(); }
+
+private:
+	struct FTimerOrder
+	{
+		bool operator()(const FGMCEffectTimer& A, const FGMCEffectTimer& B) const
+		{
+			if (A.Time != B.Time) return A.Time < B.Time;
+			if (A.EffectID != B.EffectID) return A.EffectID < B.EffectID;
+			return A.Type < B.Type;
+		}
+	};
+
+	TArray<FGMCEffectTimer> Timers;
+};
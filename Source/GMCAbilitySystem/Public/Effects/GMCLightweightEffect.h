@@ -0,0 +1,80 @@
+#pragma once
+#include "GMCAbilityEffect.h"
+
+class UGMC_AbilitySystemComponent;
+
+/**
+ * Static description of an effect class which can run without an effect object: the effect data of its class
+ * default object. Shared by every lightweight effect of the class.
+ */
+struct GMCABILITYSYSTEM_API FGMCLightweightEffectSpec
+{
+	TSubclassOf<UGMCAbilityEffect> EffectClass;
+	FGMCAbilityEffectData Data;
+
+	/**
+	 * Spec of an effect class, or null if the class can't run as a lightweight effect: it must be flagged bLightweight,
+	 * have no native parent other than UGMCAbilityEffect and implement none of its Blueprint events. Cached per class.
+	 */
+	static TSharedPtr<const FGMCLightweightEffectSpec> Get(TSubclassOf<UGMCAbilityEffect> EffectClass);
+
+	static void InvalidateCache();
+};
+
+/**
+ * Runtime state of an effect applied from a lightweight effect class, its data being read from the shared spec.
+ * Goes through the same states as UGMCAbilityEffect, minus the events a data-only class can't implement.
+ * Lightweight effects live by value in an array of their component, which is the only one to call into them.
+ * They don't tick: the component calls into them when one of their timers is due or when its active tags change.
+ */
+struct GMCABILITYSYSTEM_API FGMCLightweightEffect
+{
+	TSharedPtr<const FGMCLightweightEffectSpec> Spec;
+
+	int32 EffectID = 0;
+	double StartTime = 0;
+	double EndTime = 0;
+
+	// ActionTimer when this effect was applied, to cancel it if the server doesn't confirm it in time.
+	double ApplicationTime = 0;
+
+	// When the next period tick is due, once started.
+	double NextPeriodTime = 0;
+
+	// Set by the component when adding the effect, to recognize the timers scheduled for this instance.
+	uint32 TimerSerial = 0;
+
+	EGMASEffectState CurrentState = EGMASEffectState::Initialized;
+	bool bHasStarted = false;
+	bool bCompleted = false;
+
+	const FGMCAbilityEffectData& GetData() const { return Spec->Data; }
+
+	double GetCurrentDuration(double ActionTimer) const { return ActionTimer - ApplicationTime; }
+
+	bool HasTagRequirements() const { return !GetData().MustHaveTags.IsEmpty() || !GetData().MustNotHaveTags.IsEmpty(); }
+
+	// Full effect data of this effect, as UGMCAbilityEffect::EffectData would hold it. Copies the spec data.
+	FGMCAbilityEffectData MakeEffectData(UGMC_AbilitySystemComponent* OwnerAbilityComponent) const;
+
+	// Start the effect once its start time is reached, end it once its end time is reached.
+	void CheckState(UGMC_AbilitySystemComponent& Owner);
+
+	// End the effect if the owner's tags don't meet its MustHaveTags and MustNotHaveTags anymore.
+	void CheckTagRequirements(UGMC_AbilitySystemComponent& Owner);
+
+	// Apply the period modifiers of every period due since the last period tick (up to the end time) unless paused,
+	// and move NextPeriodTime to the next one.
+	void TickPeriod(UGMC_AbilitySystemComponent& Owner);
+
+	void EndEffect(UGMC_AbilitySystemComponent& Owner);
+
+	FString ToString(double ActionTimer) const;
+
+private:
+	void StartEffect(UGMC_AbilitySystemComponent& Owner);
+	void UpdateState(UGMC_AbilitySystemComponent& Owner, EGMASEffectState State);
+	void PeriodTick(UGMC_AbilitySystemComponent& Owner, int32 NumPeriodTicks);
+
+	int32 NumPeriodsApplied = 0;
+};
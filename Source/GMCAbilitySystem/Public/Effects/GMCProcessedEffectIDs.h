@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Effect IDs a client has processed, and whether the server confirmed them.
+ * Bounded: an ID is forgotten once it's been known for Window seconds of ActionTimer, the oldest IDs being forgotten
+ * first past MaxNum. A forgotten ID is unknown again, so Window must exceed the time the server can take to replicate
+ * an effect the client already processed (latency plus the confirmation timeout); effects still active are recognized
+ * by their ID being in use, however long ago they were processed.
+ * Unconfirmed IDs of effects still active are never forgotten, their confirmation timeout needs them: they're kept
+ * until the server confirms them or the effect ends, even past MaxNum.
+ */
+struct GMCABILITYSYSTEM_API FGMCProcessedEffectIDs
+{
+	FGMCProcessedEffectIDs() = default;
+	FGMCProcessedEffectIDs(const FGMCProcessedEffectIDs& Other) = delete;
+	FGMCProcessedEffectIDs& operator=(const FGMCProcessedEffectIDs& Other) = delete;
+	~FGMCProcessedEffectIDs();
+
+	double Window = 30.0;
+	int32 MaxNum = 4096;
+
+	// Whether the effect with this ID is still active. Unconfirmed IDs are only forgotten once it returns false.
+	TFunction<bool(int32 EffectID)> IsEffectActive;
+
+	// Add an ID processed at this ActionTimer, or update whether the server confirmed it if it's already known.
+	void Add(int32 EffectID, bool bServerConfirmed, double ActionTimer);
+
+	// Whether the server confirmed the effect, null if the ID isn't known.
+	const bool* Find(int32 EffectID) const { return ServerConfirmed.Find(EffectID); }
+
+	bool Contains(int32 EffectID) const { return ServerConfirmed.Contains(EffectID); }
+
+	// Forget the IDs processed more than Window before this ActionTimer.
+	void Expire(double ActionTimer);
+
+	int32 Num() const { return ServerConfirmed.Num(); }
+
+private:
+	// Forget the oldest ID, unless it's pending confirmation for an active effect: it's then queued again as of this
+	// ActionTimer. Returns whether an ID was forgotten.
+	bool ForgetOldest(double ActionTimer);
+
+	TMap<int32, bool> ServerConfirmed;
+
+	// IDs in the order they were added, from FirstEntry on.
+	struct FEntry
+	{
+		int32 EffectID;
+		double Time;
+	};
+	TArray<FEntry> Entries;
+	int32 FirstEntry = 0;
+};